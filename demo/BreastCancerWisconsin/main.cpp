@@ -46,8 +46,7 @@ int main() {
 
   SVM::SVM<450, 30> svm(train.begin(), [](const SVM::FixedVector<30>& a,
                                           const SVM::FixedVector<30>& b) {
-    SVM::FixedVector<30>&& d = a - b;
-    return std::exp(d.dot(d) / 0.2 * (-1)) / 30;
+    return std::exp(a.squared_distance(b) / 0.2 * (-1)) / 30;
     double x = a.dot(b);
     return x;
   });
@@ -0,0 +1,103 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "SVM.hpp"
+
+const int Dimension = 2;
+const int n = 2000;
+const std::size_t Points = 1 << 20;
+
+template <class Func>
+double measure(const Func& func) {
+  auto start = std::chrono::steady_clock::now();
+  func();
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+// 与std::exp/std::tanh对比误差与耗时，误差超出上界时返回非0
+int main() {
+  using SVM::FastMathAccuracy;
+  std::cout << std::fixed << std::setprecision(3);
+  const std::pair<FastMathAccuracy, std::string> levels[] = {
+      {FastMathAccuracy::Low, "Low"},
+      {FastMathAccuracy::Medium, "Medium"},
+      {FastMathAccuracy::High, "High"}};
+  const double bound[] = {1e-4, 1e-6, 1e-14};
+  bool passed = true;
+
+  std::vector<double> x(Points), y(Points);
+  for (std::size_t i = 0; i < Points; i++)
+    x[i] = -700 + 1400.0 * i / Points;
+  std::vector<double> expect = x;
+  double std_time = measure([&] {
+    std::ranges::for_each(expect, [](double& v) { v = std::exp(v); });
+  });
+  std::cout << std::setw(8) << "exp" << std::setw(14) << "rel error"
+            << std::setw(12) << "ms" << std::endl;
+  std::cout << std::setw(8) << "std" << std::setw(14) << 0 << std::setw(12)
+            << std_time << std::endl;
+  for (int k = 0; k < 3; k++) {
+    y = x;
+    double time =
+        measure([&] { SVM::FastExp(y.data(), Points, levels[k].first); });
+    double error = 0;
+    for (std::size_t i = 0; i < Points; i++)
+      error = std::max(error, std::abs(y[i] - expect[i]) / expect[i]);
+    passed &= error < bound[k];
+    std::cout << std::setw(8) << levels[k].second << std::setw(14)
+              << std::scientific << error
+              << std::fixed << std::setw(12) << time << std::endl;
+  }
+
+  for (std::size_t i = 0; i < Points; i++) x[i] = -20 + 40.0 * i / Points;
+  expect = x;
+  std::ranges::for_each(expect, [](double& v) { v = std::tanh(v); });
+  std::cout << std::setw(8) << "tanh" << std::setw(14) << "abs error"
+            << std::endl;
+  for (int k = 0; k < 3; k++) {
+    y = x;
+    SVM::FastTanh(y.data(), Points, levels[k].first);
+    double error = 0;
+    for (std::size_t i = 0; i < Points; i++)
+      error = std::max(error, std::abs(y[i] - expect[i]));
+    passed &= error < bound[k];
+    std::cout << std::setw(8) << levels[k].second << std::setw(14)
+              << std::scientific << error << std::fixed << std::endl;
+  }
+
+  // RBF核矩阵：逐个调用std::exp与整行FastExp
+  std::vector<SVM::Sample<Dimension>> data(n);
+  SVM::MoonTestSampleGenerator<double> gen;
+  gen.Generate(data.begin(), n);
+  std::vector<SVM::FixedVector<Dimension>> point;
+  for (auto& v : data) point.push_back(v.data);
+  const SVM::RBFKernel<Dimension> rbf{0.25};
+  SVM::KernelMatrix<double> single(n), row(n);
+  double single_time = measure([&] {
+    single.Fill([&](std::size_t i, std::size_t j) {
+      return rbf(point[i], point[j]);
+    });
+  });
+  double row_time = measure([&] { row.FillRows(point.begin(), rbf); });
+  double error = 0;
+  for (int i = 0; i < n; i++)
+    for (int j = 0; j <= i; j++)
+      error = std::max(error, std::abs(single(i, j) - row(i, j)));
+  passed &= error < bound[2];
+  std::cout << "RBF kernel matrix " << n << "x" << n << ": std::exp "
+            << single_time << " ms, FastExp rows "
+            << row_time << " ms, max error " << std::scientific << error
+            << std::endl;
+
+  std::cout << (passed ? "passed" : "FAILED") << std::endl;
+  return passed ? 0 : 1;
+}
\ No newline at end of file
@@ -13,10 +13,11 @@ void output(double x) {
   std::cout << std::fixed << std::setprecision(6) << std::setw(9) << x << " ";
 }
 int main() {
-  std::vector<SVM::Sample<Dimension>> data;
+  std::vector<SVM::Sample<Dimension>> data(n);
   SVM::LinearTestSampleGenerator<Dimension> gen(
       std::chrono::system_clock::now().time_since_epoch().count());
-  for (int i = 0; i < n; i++) data.push_back(gen());
+  // 并行批量生成，结果只由种子决定
+  gen.Generate(data.begin(), n);
   auto Seg = gen.GetSegmentation();
   std::ranges::for_each(Seg.weight, output);
   std::cout << "+ ";
@@ -46,8 +46,7 @@ int main() {
 
   SVM::SVM<n, Dimension> svm(data.begin(), [](const SVM::FixedVector<2>& a,
                                               const SVM::FixedVector<2>& b) {
-    SVM::FixedVector<2>&& d = a - b;
-    return std::exp(d.dot(d) / 0.01 * (-1));
+    return std::exp(a.squared_distance(b) / 0.01 * (-1));
   });
 
   std::size_t progress = 0;
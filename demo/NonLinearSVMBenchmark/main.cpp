@@ -37,12 +37,11 @@ int main() {
     }
   }
 
-  SVM::SVM<n, Dimension> svm(data.begin(), [](const SVM::FixedVector<2> &a,
-                                              const SVM::FixedVector<2> &b) {
-    auto x = a.dot(b);
-    return x * x * x;
-    SVM::FixedVector<2> &&d = a - b;
-    return std::exp(d.dot(d) / 0.25 * (-1));
+  const SVM::PolynomialKernel<Dimension> cubic{3};
+  SVM::SVM<n, Dimension> svm(data.begin(), [&](const SVM::FixedVector<2> &a,
+                                               const SVM::FixedVector<2> &b) {
+    return cubic(a, b);
+    return std::exp(a.squared_distance(b) / 0.25 * (-1));
   });
 
   std::size_t progress = 0;
@@ -96,17 +95,12 @@ int main() {
     out << p[0] << "," << p[1] << "," << c << ","
         << (SVM::sgn(svm.lambda[i++]) ? 3 : 1) << std::endl;
 
-  // 运算量较大，会卡顿
-  const int Slice = 1000;
-  for (int i = 0; i < Slice; i++)
-    for (int j = 0; j < Slice; j++) {
-      double x = i, y = j;
-      x = -4.5 + 9 * (x / Slice);
-      y = -4.5 + 9 * (y / Slice);
-      SVM::FixedVector<2> f;
-      f = {x, y};
-      out << svm(f) << std::endl;
-    }
+  // 将支持向量合并为三次多项式的系数，预测代价与支持向量数量无关
+  SVM::PolynomialSVM<Dimension> psvm(svm, cubic);
+  // 分块并行求值，按大块缓冲写出
+  const std::size_t Slice = 1000;
+  SVM::Grid<Dimension> grid{{-4.5, -4.5}, {4.5, 4.5}, {Slice, Slice}};
+  SVM::Rasterize(psvm, grid, out);
   out.close();
 
   return 0;
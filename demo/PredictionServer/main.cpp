@@ -0,0 +1,236 @@
+#include <pthread.h>
+#include <signal.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "SVM.hpp"
+
+const int Dimension = 2;
+const int n = 300;
+
+using Registry = SVM::ModelRegistry<Dimension>;
+using Server = SVM::PredictionServer<Dimension>;
+using Client = SVM::PredictionClient<Dimension>;
+
+void usage() {
+  std::cout
+      << "usage:\n"
+         "  PredictionServer\n"
+         "      self check: serve two model versions and hot-swap under load\n"
+         "  PredictionServer train <file> [width]\n"
+         "  PredictionServer serve <socket> <name>=<file>...\n"
+         "  PredictionServer load <socket> <name> <file>\n"
+         "  PredictionServer stats <socket>\n"
+         "  PredictionServer bench <socket> <name> [clients] [requests] "
+         "[rows]"
+      << std::endl;
+}
+
+// 在双月牙数据上训练RBF核模型并保存
+SVM::CompactSVM<Dimension> train(const std::string& file, double width,
+                                 std::size_t seed) {
+  std::vector<SVM::Sample<Dimension>> data(n);
+  SVM::MoonTestSampleGenerator<> gen(seed, 0.5);
+  gen.Generate(data.begin(), n);
+  auto svm = SVM::CascadeSMO<Dimension>(data.begin(), data.end(),
+                                        SVM::RBFKernel<Dimension>{width}, 1.0,
+                                        20, 1e-3, 4, 1, seed);
+  std::ofstream os(file, std::ios::binary);
+  SVM::SaveModel(os, svm);
+  return svm;
+}
+
+void report(const std::string& title, const SVM::LatencyReport& r) {
+  std::cout << title << ": " << r.requests << " requests, " << r.batches
+            << " batches, " << std::setprecision(1)
+            << (r.batches ? double(r.rows) / r.batches : 0)
+            << " rows/batch, p50 " << r.p50 << " us, p99 " << r.p99
+            << " us, max " << r.max << " us" << std::endl;
+}
+
+// clients个连接并发发送requests个rows行的打分请求，返回客户端延迟
+// check不为空时用其校验每个响应
+template <class Check>
+SVM::LatencyReport bench(const std::string& socket, const std::string& name,
+                         std::size_t clients, std::size_t requests,
+                         std::size_t rows, const Check& check) {
+  std::vector<std::vector<double>> latency(clients);
+  std::vector<std::jthread> workers;
+  for (std::size_t c = 0; c < clients; c++)
+    workers.emplace_back([&, c] {
+      try {
+        Client client(socket);
+        std::mt19937 engine(c);
+        std::uniform_real_distribution<double> coordinate(-3, 3);
+        std::vector<SVM::FixedVector<Dimension>> data(rows);
+        std::vector<double> result(rows);
+        for (std::size_t r = 0; r < requests; r++) {
+          for (auto& x : data) x = {coordinate(engine), coordinate(engine)};
+          auto start = std::chrono::steady_clock::now();
+          client.Score(name, data.begin(), data.end(), result.begin());
+          latency[c].push_back(std::chrono::duration<double, std::micro>(
+                                   std::chrono::steady_clock::now() - start)
+                                   .count());
+          check(data, result);
+        }
+      } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+      }
+    });
+  workers.clear();
+
+  std::vector<double> all;
+  for (auto& l : latency) all.insert(all.end(), l.begin(), l.end());
+  SVM::LatencyReport r;
+  if (all.empty()) return r;
+  r.requests = all.size();
+  r.rows = all.size() * rows;
+  std::ranges::sort(all);
+  r.p50 = all[(all.size() - 1) / 2];
+  r.p99 = all[(all.size() - 1) * 99 / 100];
+  r.max = all.back();
+  return r;
+}
+
+// 等待服务端开始监听
+void wait_for(const std::string& socket) {
+  for (bool connected = false; !connected;) {
+    try {
+      Client client(socket);
+      connected = true;
+    } catch (const std::runtime_error&) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  }
+}
+
+int self_check() {
+  const auto dir = std::filesystem::temp_directory_path() /
+                   ("svm_prediction_server_" + std::to_string(::getpid()));
+  std::filesystem::create_directories(dir);
+  const std::string socket = dir / "server.sock", old_file = dir / "old.svm",
+                    new_file = dir / "new.svm";
+  const auto old_svm = train(old_file, 0.5, 1),
+             new_svm = train(new_file, 1.0, 2);
+  std::cout << "trained models with " << old_svm.support.size() << " and "
+            << new_svm.support.size() << " support vectors" << std::endl;
+
+  Registry registry;
+  registry.Load("moon", old_file);
+  Server server(registry, socket);
+  std::jthread runner([&] { server.Run(); });
+  wait_for(socket);
+
+  // 热替换期间每个响应须与某一版本的模型完全对应
+  std::atomic<std::size_t> mismatch = 0;
+  auto check = [&](const auto& data, const auto& result) {
+    auto match = [&](const auto& svm) {
+      for (std::size_t i = 0; i < data.size(); i++)
+        if (std::abs(svm.Decision(data[i]) - result[i]) > 1e-9) return false;
+      return true;
+    };
+    if (!match(old_svm) && !match(new_svm)) mismatch++;
+  };
+  std::jthread swapper([&] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    const auto version = Client(socket).Load("moon", new_file);
+    std::cout << "hot-swapped to version " << version << std::endl;
+  });
+  report("client", bench(socket, "moon", 8, 500, 4, check));
+  swapper.join();
+  report("server", Client(socket).Stats());
+
+  server.Stop();
+  runner.join();
+  std::filesystem::remove_all(dir);
+  const bool passed = mismatch == 0 && registry.Find("moon")->version == 2;
+  std::cout << mismatch << " mismatched responses" << std::endl;
+  std::cout << (passed ? "passed" : "FAILED") << std::endl;
+  return passed ? 0 : 1;
+}
+
+int serve(const std::string& socket, int argc, char** argv) {
+  Registry registry;
+  for (int i = 0; i < argc; i++) {
+    const std::string spec = argv[i];
+    const auto eq = spec.find('=');
+    if (eq == std::string::npos) {
+      usage();
+      return 1;
+    }
+    const auto version =
+        registry.Load(spec.substr(0, eq), spec.substr(eq + 1));
+    std::cout << "loaded " << spec.substr(0, eq) << " version " << version
+              << std::endl;
+  }
+
+  // 由专门的线程等待退出信号
+  sigset_t signals;
+  sigemptyset(&signals);
+  sigaddset(&signals, SIGINT);
+  sigaddset(&signals, SIGTERM);
+  pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+  Server server(registry, socket);
+  std::jthread waiter([&] {
+    int signal;
+    sigwait(&signals, &signal);
+    server.Stop();
+  });
+  std::cout << "listening on " << socket << std::endl;
+  try {
+    server.Run();
+  } catch (...) {
+    // 监听失败时唤醒等待信号的线程
+    pthread_kill(waiter.native_handle(), SIGTERM);
+    throw;
+  }
+  report("server", server.Latency());
+  return 0;
+}
+
+int main(int argc, char** argv) {
+  std::cout << std::fixed;
+  try {
+    if (argc == 1) return self_check();
+    const std::string command = argv[1];
+    if (command == "train" && argc >= 3) {
+      const auto svm = train(argv[2], argc >= 4 ? std::stod(argv[3]) : 0.5,
+                             std::random_device()());
+      std::cout << svm.support.size() << " support vectors" << std::endl;
+    } else if (command == "serve" && argc >= 3)
+      return serve(argv[2], argc - 3, argv + 3);
+    else if (command == "load" && argc == 5) {
+      const auto version = Client(argv[2]).Load(argv[3], argv[4]);
+      std::cout << "version " << version << std::endl;
+    } else if (command == "stats" && argc == 3)
+      report("server", Client(argv[2]).Stats());
+    else if (command == "bench" && argc >= 4) {
+      auto arg = [&](int i, std::size_t value) {
+        return argc > i ? std::stoul(argv[i]) : value;
+      };
+      report("client", bench(argv[2], argv[3], arg(4, 8), arg(5, 1000),
+                             arg(6, 4), [](const auto&, const auto&) {}));
+      report("server", Client(argv[2]).Stats());
+    } else {
+      usage();
+      return 1;
+    }
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << std::endl;
+    return 1;
+  }
+  return 0;
+}
\ No newline at end of file
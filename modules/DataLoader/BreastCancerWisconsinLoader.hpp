@@ -10,15 +10,18 @@
 #include <utility>
 #include <vector>
 
+#include "Normalization/Normalizer.hpp"
 #include "Sample/Sample.hpp"
 
 namespace SVMDataLoader {
 // 基于数据维数特化威斯康星乳腺癌数据集的三种规格，请保证数据维数和文件对应
+// 给出normalizer时返回原始特征并输出拟合的min-max变换，否则返回变换后的特征
 template <std::size_t Dimension, std::size_t TrainDataSize,
           std::floating_point svm_float_t,
           class sample_t = SVM::Sample<Dimension - 2, svm_float_t>>
 std::pair<std::vector<sample_t>, std::vector<sample_t>> BreastCancerWisconsin(
-    const std::string& file_path, std::size_t seed = 0) {
+    const std::string& file_path, std::size_t seed = 0,
+    SVM::Normalizer<Dimension - 2, svm_float_t>* normalizer = nullptr) {
   constexpr std::size_t DataSetSize = Dimension == 35   ? 198
                                       : Dimension == 32 ? 569
                                                         : 699;
@@ -73,20 +76,14 @@ std::pair<std::vector<sample_t>, std::vector<sample_t>> BreastCancerWisconsin(
   std::vector<sample_t> sample;
   sample.reserve(DataSetSize);
   for (int i = 0; i < DataSetSize; i++) sample.push_back(get_sample());
-  // 重映射到0-1
-  for (int i = 0; i < Dimension - 2; i++) {
-    svm_float_t minv = sample[0].data[i], maxv = minv;
-    for (int j = 1; j < DataSetSize; j++) {
-      const svm_float_t& v = sample[j].data[i];
-      if (v > maxv)
-        maxv = v;
-      else if (v < minv)
-        minv = v;
-    }
-    for (int j = 0; j < DataSetSize; j++)
-      sample[j].data[i] = (sample[j].data[i] - minv) / (maxv - minv);
-  }
   data_file.close();
+  // 重映射到0-1
+  const auto transform = SVM::Normalizer<Dimension - 2, svm_float_t>::Fit(
+      sample.begin(), sample.end(), SVM::NormalizeMode::MinMax);
+  if (normalizer)
+    *normalizer = transform;
+  else
+    transform.Apply(sample.begin(), sample.end());
 
   // 打乱数据
   static std::mt19937 Engine(seed);
@@ -0,0 +1,100 @@
+#ifndef __SVM_COALESCED_DATA_SET_HPP__
+#define __SVM_COALESCED_DATA_SET_HPP__
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+#include "Sample/Sample.hpp"
+#include "common/common.hpp"
+
+namespace SVM {
+
+// 合并重复样本后的数据集，weight[i]为sample[i]所代表的原样本数
+template <std::size_t Dimension, std::floating_point svm_float_t = double>
+struct CoalescedDataSet {
+  std::vector<Sample<Dimension, svm_float_t>> sample;
+  std::vector<svm_float_t> weight;
+
+  std::size_t Size() const { return sample.size(); }
+};
+
+// 将[first, last)中分类相同且特征向量重复的样本合并为一个加权样本
+// Epsilon为0时只合并完全相同的向量；Epsilon > 0时按边长Epsilon的网格量化，
+// 同一格内同类样本合并为其均值，合并前各分量之差均小于Epsilon
+// 以样本权重作为lambda上界的倍数训练时，合并完全相同的样本不改变对偶问题的解
+// 网格坐标超出int64范围（含无穷）时截断，为NaN时抛出异常
+template <std::size_t Dimension, std::floating_point svm_float_t = double,
+          std::forward_iterator forwardIt>
+CoalescedDataSet<Dimension, svm_float_t> CoalesceSamples(
+    forwardIt first, forwardIt last, svm_float_t Epsilon = 0);
+
+}  // namespace SVM
+
+//////////implementation//////////
+
+namespace SVM {
+
+template <std::size_t Dimension, std::floating_point svm_float_t,
+          std::forward_iterator forwardIt>
+CoalescedDataSet<Dimension, svm_float_t> CoalesceSamples(
+    forwardIt first, forwardIt last, svm_float_t Epsilon) {
+  // 键为各分量的位模式或网格坐标，末位为分类
+  using key_t = std::array<int64_t, Dimension + 1>;
+  struct Hash {
+    std::size_t operator()(const key_t& key) const {
+      // FNV-1a
+      uint64_t h = 14695981039346656037ull;
+      for (int64_t v : key) h = (h ^ uint64_t(v)) * 1099511628211ull;
+      return h;
+    }
+  };
+
+  // 以下判断均在位模式上进行，-Ofast会假定浮点数有限且不区分正负零
+  constexpr uint64_t Sign = uint64_t(1) << 63, Infinity = 0x7ffull << 52;
+  CoalescedDataSet<Dimension, svm_float_t> result;
+  std::unordered_map<key_t, std::size_t, Hash> position;
+  for (; first != last; ++first) {
+    const auto& [y, x] = *first;
+    key_t key;
+    for (std::size_t d = 0; d < Dimension; d++)
+      if (Epsilon > 0) {
+        const double cell = std::floor(double(x[d]) / Epsilon);
+        if ((std::bit_cast<uint64_t>(cell) & ~Sign) > Infinity)
+          throw std::runtime_error("Fail to coalesce NaN sample.");
+        key[d] = int64_t(std::clamp(cell, -0x1p62, 0x1p62));
+      } else {
+        // -0与0仅符号位不同，合并为同一个键
+        uint64_t bits = std::bit_cast<uint64_t>(double(x[d]));
+        if ((bits & ~Sign) == 0) bits = 0;
+        key[d] = int64_t(bits);
+      }
+    key[Dimension] = y;
+
+    auto [it, inserted] = position.try_emplace(key, result.sample.size());
+    if (inserted) {
+      result.sample.push_back(*first);
+      result.weight.push_back(1);
+      continue;
+    }
+    // 增量更新均值，完全相同的向量保持不变
+    auto& merged = result.sample[it->second].data;
+    svm_float_t& w = result.weight[it->second];
+    w += 1;
+    if (Epsilon > 0)
+      for (std::size_t d = 0; d < Dimension; d++)
+        merged[d] += (x[d] - merged[d]) / w;
+  }
+  return result;
+}
+
+}  // namespace SVM
+
+#endif
\ No newline at end of file
@@ -0,0 +1,195 @@
+#ifndef __SVM_MAPPED_DATA_SET_HPP__
+#define __SVM_MAPPED_DATA_SET_HPP__
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "Sample/Sample.hpp"
+#include "common/common.hpp"
+
+namespace SVM {
+
+// 磁盘样本矩阵文件格式：文件头后紧接每个样本一条记录
+// 记录为Dimension + 1个svm_float_t，首个为分类，其后为数据
+struct MappedDataSetHeader {
+  char magic[8] = {'S', 'V', 'M', 'D', 'A', 'T', 'A', '\0'};
+  uint64_t dimension = 0;
+  uint64_t count = 0;
+  uint64_t float_size = 0;
+};
+
+// 以内存映射只读访问磁盘上的样本矩阵，数据集可大于内存
+template <std::size_t Dimension, std::floating_point svm_float_t = double>
+class MappedDataSet {
+  static constexpr std::size_t RecordSize = Dimension + 1;
+
+  int fd = -1;
+  void* base = MAP_FAILED;
+  std::size_t bytes = 0;
+  std::size_t count = 0;
+  const svm_float_t* record = nullptr;
+
+  void Advise(std::size_t, std::size_t, int) const;
+
+ public:
+  explicit MappedDataSet(const std::string& file_path);
+  MappedDataSet(const MappedDataSet&) = delete;
+  MappedDataSet& operator=(const MappedDataSet&) = delete;
+  ~MappedDataSet();
+
+  std::size_t Size() const { return count; }
+  // 存储值不为±1时返回0，不对任意浮点数做整数转换
+  ClassificationType Label(std::size_t i) const {
+    const svm_float_t y = record[i * RecordSize];
+    return y == 1 ? 1 : y == -1 ? -1 : 0;
+  }
+  const svm_float_t* Row(std::size_t i) const {
+    return record + i * RecordSize + 1;
+  }
+  FixedVector<Dimension, svm_float_t> Data(std::size_t) const;
+  Sample<Dimension, svm_float_t> operator[](std::size_t i) const {
+    return {Label(i), Data(i)};
+  }
+
+  // 提示内核预读/释放[first, last)的样本
+  void WillNeed(std::size_t first, std::size_t last) const {
+    Advise(first, last, MADV_WILLNEED);
+  }
+  void DontNeed(std::size_t first, std::size_t last) const {
+    Advise(first, last, MADV_DONTNEED);
+  }
+};
+
+// 以大块缓冲顺序写出样本矩阵文件
+template <std::size_t Dimension, std::floating_point svm_float_t = double>
+class MappedDataSetWriter {
+  std::ofstream file;
+  MappedDataSetHeader header;
+  std::vector<char> buffer = std::vector<char>(1 << 24);
+
+ public:
+  explicit MappedDataSetWriter(const std::string& file_path);
+  ~MappedDataSetWriter() { Close(); }
+
+  void operator()(const Sample<Dimension, svm_float_t>&);
+  // 回填样本数量，写出后文件即可被MappedDataSet读取
+  void Close();
+};
+
+}  // namespace SVM
+
+//////////implementation//////////
+
+namespace SVM {
+
+template <std::size_t Dimension, std::floating_point svm_float_t>
+MappedDataSet<Dimension, svm_float_t>::MappedDataSet(
+    const std::string& file_path) {
+  fd = ::open(file_path.c_str(), O_RDONLY);
+  if (fd < 0)
+    throw std::runtime_error("Fail to open data file at " + file_path + ".");
+  struct stat st;
+  if (::fstat(fd, &st) != 0 ||
+      std::size_t(st.st_size) < sizeof(MappedDataSetHeader)) {
+    ::close(fd);
+    throw std::runtime_error("Invalid data file at " + file_path + ".");
+  }
+  bytes = st.st_size;
+  base = ::mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0);
+  if (base == MAP_FAILED) {
+    ::close(fd);
+    throw std::runtime_error("Fail to map data file at " + file_path + ".");
+  }
+
+  MappedDataSetHeader header;
+  std::memcpy(&header, base, sizeof(header));
+  count = header.count;
+  // 以除法比较，避免损坏的count使乘积回绕而通过检查
+  if (std::memcmp(header.magic, MappedDataSetHeader().magic, 8) != 0 ||
+      header.dimension != Dimension ||
+      header.float_size != sizeof(svm_float_t) ||
+      header.count >
+          (bytes - sizeof(header)) / (RecordSize * sizeof(svm_float_t))) {
+    ::munmap(base, bytes);
+    ::close(fd);
+    throw std::runtime_error("Mismatched data file at " + file_path + ".");
+  }
+  record = reinterpret_cast<const svm_float_t*>(
+      static_cast<const char*>(base) + sizeof(header));
+}
+
+template <std::size_t Dimension, std::floating_point svm_float_t>
+MappedDataSet<Dimension, svm_float_t>::~MappedDataSet() {
+  if (base != MAP_FAILED) ::munmap(base, bytes);
+  if (fd >= 0) ::close(fd);
+}
+
+template <std::size_t Dimension, std::floating_point svm_float_t>
+FixedVector<Dimension, svm_float_t> MappedDataSet<Dimension, svm_float_t>::Data(
+    std::size_t i) const {
+  FixedVector<Dimension, svm_float_t> data;
+  std::copy_n(Row(i), Dimension, data.begin());
+  return data;
+}
+
+template <std::size_t Dimension, std::floating_point svm_float_t>
+void MappedDataSet<Dimension, svm_float_t>::Advise(std::size_t first,
+                                                   std::size_t last,
+                                                   int advice) const {
+  last = std::min(last, count);
+  if (first >= last) return;
+  // madvise要求起始地址按页对齐
+  const std::size_t page = ::sysconf(_SC_PAGESIZE);
+  std::size_t begin = sizeof(MappedDataSetHeader) +
+                      first * RecordSize * sizeof(svm_float_t);
+  std::size_t end =
+      sizeof(MappedDataSetHeader) + last * RecordSize * sizeof(svm_float_t);
+  begin -= begin % page;
+  ::madvise(static_cast<char*>(base) + begin, end - begin, advice);
+}
+
+template <std::size_t Dimension, std::floating_point svm_float_t>
+MappedDataSetWriter<Dimension, svm_float_t>::MappedDataSetWriter(
+    const std::string& file_path)
+    : file(file_path, std::ios::binary | std::ios::out | std::ios::trunc) {
+  if (!file.is_open())
+    throw std::runtime_error("Fail to open data file at " + file_path + ".");
+  file.rdbuf()->pubsetbuf(buffer.data(), buffer.size());
+  header.dimension = Dimension;
+  header.float_size = sizeof(svm_float_t);
+  file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+}
+
+template <std::size_t Dimension, std::floating_point svm_float_t>
+void MappedDataSetWriter<Dimension, svm_float_t>::operator()(
+    const Sample<Dimension, svm_float_t>& sample) {
+  svm_float_t classification = sample.classification;
+  file.write(reinterpret_cast<const char*>(&classification),
+             sizeof(svm_float_t));
+  for (const auto& x : sample.data)
+    file.write(reinterpret_cast<const char*>(&x), sizeof(svm_float_t));
+  header.count++;
+}
+
+template <std::size_t Dimension, std::floating_point svm_float_t>
+void MappedDataSetWriter<Dimension, svm_float_t>::Close() {
+  if (!file.is_open()) return;
+  file.seekp(0);
+  file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  file.close();
+}
+
+}  // namespace SVM
+
+#endif
\ No newline at end of file
@@ -0,0 +1,202 @@
+#ifndef __SVM_MAPPED_GRAM_MATRIX_HPP__
+#define __SVM_MAPPED_GRAM_MATRIX_HPP__
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "common/common.hpp"
+
+namespace SVM {
+
+enum class GramLayout : uint64_t {
+  Full,  // rows * cols个元素，按行存储
+  Upper  // 对称方阵的上三角(含对角线)，按行紧凑存储
+};
+
+// 预计算核矩阵文件格式：文件头后紧接按layout排列的元素
+// 元素为float或double，由float_size指明；训练用方阵，预测用测试集 * 训练集矩阵
+struct MappedGramMatrixHeader {
+  char magic[8] = {'S', 'V', 'M', 'G', 'R', 'A', 'M', '\0'};
+  uint64_t rows = 0;
+  uint64_t cols = 0;
+  uint64_t float_size = 0;
+  GramLayout layout = GramLayout::Full;
+};
+
+// 以内存映射只读访问离线计算的核矩阵，读取时转换为svm_float_t
+template <std::floating_point svm_float_t = double>
+class MappedGramMatrix {
+  int fd = -1;
+  void* base = MAP_FAILED;
+  std::size_t bytes = 0;
+  MappedGramMatrixHeader header;
+  const char* element = nullptr;
+
+  std::size_t Offset(std::size_t, std::size_t) const;
+
+ public:
+  explicit MappedGramMatrix(const std::string& file_path);
+  MappedGramMatrix(const MappedGramMatrix&) = delete;
+  MappedGramMatrix& operator=(const MappedGramMatrix&) = delete;
+  ~MappedGramMatrix();
+
+  std::size_t Rows() const { return header.rows; }
+  std::size_t Cols() const { return header.cols; }
+  GramLayout Layout() const { return header.layout; }
+
+  svm_float_t operator()(std::size_t i, std::size_t j) const {
+    const std::size_t k = Offset(i, j);
+    if (header.float_size == sizeof(float))
+      return reinterpret_cast<const float*>(element)[k];
+    return reinterpret_cast<const double*>(element)[k];
+  }
+
+  // 提示内核预读整个矩阵
+  void WillNeed() const;
+};
+
+// 以大块缓冲顺序写出核矩阵文件，元素按layout的存储顺序逐个写入
+template <std::floating_point file_float_t = double>
+class MappedGramMatrixWriter {
+  std::ofstream file;
+  MappedGramMatrixHeader header;
+  std::size_t written = 0;
+  std::vector<char> buffer = std::vector<char>(1 << 24);
+
+ public:
+  MappedGramMatrixWriter(const std::string& file_path, std::size_t rows,
+                         std::size_t cols, GramLayout = GramLayout::Full);
+  // 未调用Close时直接关闭文件，元素不足的文件会被MappedGramMatrix拒绝
+  ~MappedGramMatrixWriter() {
+    if (file.is_open()) file.close();
+  }
+
+  void operator()(file_float_t);
+  // 检查元素数量，写出后文件即可被MappedGramMatrix读取
+  void Close();
+};
+
+}  // namespace SVM
+
+//////////implementation//////////
+
+namespace SVM {
+
+template <std::floating_point svm_float_t>
+MappedGramMatrix<svm_float_t>::MappedGramMatrix(const std::string& file_path) {
+  fd = ::open(file_path.c_str(), O_RDONLY);
+  if (fd < 0)
+    throw std::runtime_error("Fail to open gram file at " + file_path + ".");
+  struct stat st;
+  if (::fstat(fd, &st) != 0 ||
+      std::size_t(st.st_size) < sizeof(MappedGramMatrixHeader)) {
+    ::close(fd);
+    throw std::runtime_error("Invalid gram file at " + file_path + ".");
+  }
+  bytes = st.st_size;
+  base = ::mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0);
+  if (base == MAP_FAILED) {
+    ::close(fd);
+    throw std::runtime_error("Fail to map gram file at " + file_path + ".");
+  }
+
+  std::memcpy(&header, base, sizeof(header));
+  // 行列数先与文件可容纳的元素数比较，再以除法判断乘积，避免回绕
+  const uint64_t capacity = (bytes - sizeof(header)) /
+                            std::max<uint64_t>(1, header.float_size);
+  auto fits = [&](uint64_t a, uint64_t b) {
+    return b == 0 || a <= capacity / b;
+  };
+  // Upper布局共rows * (rows + 1) / 2个元素，先约去因子2
+  const uint64_t rows = header.rows, cols = header.cols;
+  const bool in_range =
+      rows <= capacity && cols <= capacity &&
+      (header.layout == GramLayout::Upper
+           ? (rows % 2 == 0 ? fits(rows / 2, rows + 1)
+                            : fits(rows, (rows + 1) / 2))
+           : fits(rows, cols));
+  if (std::memcmp(header.magic, MappedGramMatrixHeader().magic, 8) != 0 ||
+      (header.float_size != sizeof(float) &&
+       header.float_size != sizeof(double)) ||
+      (header.layout != GramLayout::Full &&
+       header.layout != GramLayout::Upper) ||
+      (header.layout == GramLayout::Upper && header.rows != header.cols) ||
+      !in_range) {
+    ::munmap(base, bytes);
+    ::close(fd);
+    throw std::runtime_error("Mismatched gram file at " + file_path + ".");
+  }
+  element = static_cast<const char*>(base) + sizeof(header);
+}
+
+template <std::floating_point svm_float_t>
+MappedGramMatrix<svm_float_t>::~MappedGramMatrix() {
+  if (base != MAP_FAILED) ::munmap(base, bytes);
+  if (fd >= 0) ::close(fd);
+}
+
+template <std::floating_point svm_float_t>
+std::size_t MappedGramMatrix<svm_float_t>::Offset(std::size_t i,
+                                                  std::size_t j) const {
+  if (header.layout == GramLayout::Full) return i * header.cols + j;
+  // 上三角第i行从第i列开始，之前共有i * n - i * (i - 1) / 2个元素
+  if (i > j) std::swap(i, j);
+  return i * header.rows - i * (i - 1) / 2 + (j - i);
+}
+
+template <std::floating_point svm_float_t>
+void MappedGramMatrix<svm_float_t>::WillNeed() const {
+  ::madvise(base, bytes, MADV_WILLNEED);
+}
+
+template <std::floating_point file_float_t>
+MappedGramMatrixWriter<file_float_t>::MappedGramMatrixWriter(
+    const std::string& file_path, std::size_t rows, std::size_t cols,
+    GramLayout layout)
+    : file(file_path, std::ios::binary | std::ios::out | std::ios::trunc) {
+  if (!file.is_open())
+    throw std::runtime_error("Fail to open gram file at " + file_path + ".");
+  if (layout == GramLayout::Upper && rows != cols)
+    throw std::runtime_error("Fail to write non-square upper gram matrix.");
+  file.rdbuf()->pubsetbuf(buffer.data(), buffer.size());
+  header.rows = rows;
+  header.cols = cols;
+  header.float_size = sizeof(file_float_t);
+  header.layout = layout;
+  file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+}
+
+template <std::floating_point file_float_t>
+void MappedGramMatrixWriter<file_float_t>::operator()(file_float_t value) {
+  file.write(reinterpret_cast<const char*>(&value), sizeof(file_float_t));
+  written++;
+}
+
+template <std::floating_point file_float_t>
+void MappedGramMatrixWriter<file_float_t>::Close() {
+  if (!file.is_open()) return;
+  file.close();
+  const std::size_t count = header.layout == GramLayout::Upper
+                                ? header.rows * (header.rows + 1) / 2
+                                : header.rows * header.cols;
+  if (written != count)
+    throw std::runtime_error("Fail to write gram file: element count " +
+                             std::to_string(written) + " != " +
+                             std::to_string(count) + ".");
+}
+
+}  // namespace SVM
+
+#endif
\ No newline at end of file
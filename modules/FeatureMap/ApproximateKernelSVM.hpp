@@ -0,0 +1,95 @@
+#ifndef __SVM_APPROXIMATE_KERNEL_SVM_HPP__
+#define __SVM_APPROXIMATE_KERNEL_SVM_HPP__
+
+#include <cstddef>
+#include <iterator>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "Optimizer/ParallelDCD.hpp"
+#include "SVM/SVM.hpp"
+#include "Sample/Sample.hpp"
+#include "common/Parallel.hpp"
+#include "common/common.hpp"
+
+namespace SVM {
+
+// 近似核SVM：先以FeatureMap将样本显式映射，再用线性求解器训练
+// 预测时以同样的映射作用于输入，代价为O(Components)
+template <class FeatureMap>
+struct ApproximateKernelSVM {
+  using svm_float_t = typename FeatureMap::value_type;
+  static constexpr std::size_t Dimension = FeatureMap::Dimension;
+  static constexpr std::size_t Components = FeatureMap::Components;
+
+  FeatureMap map;
+  LinearSVM<Components, svm_float_t> linear;
+
+  ApproximateKernelSVM(const FeatureMap& _map,
+                       const LinearSVM<Components, svm_float_t>& _linear)
+      : map(_map), linear(_linear) {}
+
+  // 决策函数值，符号即为分类
+  svm_float_t Decision(const FixedVector<Dimension, svm_float_t>&) const;
+  ClassificationType operator()(
+      const FixedVector<Dimension, svm_float_t>&) const;
+};
+
+// 映射[first, last)后以ParallelDCD的对偶坐标下降训练，每轮代价为
+// O(N * Components)；映射后的样本只保存一份，参数含义同ParallelDCD
+template <class FeatureMap, std::random_access_iterator randomIt>
+ApproximateKernelSVM<FeatureMap> ApproximateKernelSMO(
+    randomIt first, randomIt last, const FeatureMap& map,
+    typename FeatureMap::value_type Tolerance, std::size_t EpochLimit,
+    typename FeatureMap::value_type ModifyLimit, std::size_t seed = 0,
+    std::size_t Threads = DefaultThreads(),
+    const DataCallback<std::size_t>& EpochCallback = [](std::size_t) {},
+    const DataCallback<typename FeatureMap::value_type>& ModifyCallback =
+        [](typename FeatureMap::value_type) {});
+
+}  // namespace SVM
+
+//////////implementation//////////
+
+namespace SVM {
+
+template <class FeatureMap>
+typename FeatureMap::value_type ApproximateKernelSVM<FeatureMap>::Decision(
+    const FixedVector<Dimension, svm_float_t>& data) const {
+  return linear.Decision(map(data));
+}
+
+template <class FeatureMap>
+ClassificationType ApproximateKernelSVM<FeatureMap>::operator()(
+    const FixedVector<Dimension, svm_float_t>& data) const {
+  return sgn(Decision(data));
+}
+
+template <class FeatureMap, std::random_access_iterator randomIt>
+ApproximateKernelSVM<FeatureMap> ApproximateKernelSMO(
+    randomIt first, randomIt last, const FeatureMap& map,
+    typename FeatureMap::value_type Tolerance, std::size_t EpochLimit,
+    typename FeatureMap::value_type ModifyLimit, std::size_t seed,
+    std::size_t Threads, const DataCallback<std::size_t>& EpochCallback,
+    const DataCallback<typename FeatureMap::value_type>& ModifyCallback) {
+  using svm_float_t = typename FeatureMap::value_type;
+  constexpr std::size_t Components = FeatureMap::Components;
+
+  const std::size_t n = last - first;
+  if (n == 0) throw std::runtime_error("Fail to train on no sample.");
+  std::vector<Sample<Components, svm_float_t>> mapped(n);
+  ParallelFor(
+      n, [&](std::size_t i) { mapped[i] = map(first[i]); }, Threads);
+
+  std::vector<svm_float_t> lambda(n);
+  const auto plane = ParallelDCDSolve<Components>(
+      mapped.begin(), [&](std::size_t) { return Tolerance; },
+      std::span<svm_float_t>(lambda), EpochLimit, ModifyLimit, seed, Threads,
+      EpochCallback, ModifyCallback);
+  return {map, LinearSVM<Components, svm_float_t>(plane)};
+}
+
+}  // namespace SVM
+
+#endif
\ No newline at end of file
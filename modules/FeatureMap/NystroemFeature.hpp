@@ -0,0 +1,136 @@
+#ifndef __SVM_NYSTROEM_FEATURE_HPP__
+#define __SVM_NYSTROEM_FEATURE_HPP__
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "Sample/Sample.hpp"
+#include "common/common.hpp"
+
+namespace SVM {
+
+// Nyström近似：以Components个地标样本张成的子空间近似任意核函数
+// 映射为 L^-1 * [K(x, l_1), ..., K(x, l_m)]，其中 K_mm = L * L^T
+template <std::size_t _Dimension, std::size_t _Components,
+          std::floating_point svm_float_t = double>
+class NystroemFeature {
+ public:
+  static constexpr std::size_t Dimension = _Dimension;
+  static constexpr std::size_t Components = _Components;
+  using value_type = svm_float_t;
+  using input_t = FixedVector<Dimension, svm_float_t>;
+  using output_t = FixedVector<Components, svm_float_t>;
+  using input_sample_t = Sample<Dimension, svm_float_t>;
+  using output_sample_t = Sample<Components, svm_float_t>;
+  using kernel_function_t =
+      std::function<svm_float_t(const input_t&, const input_t&)>;
+
+ private:
+  std::array<input_t, Components> landmark;
+  // K_mm的Cholesky分解下三角，按行存储
+  std::vector<svm_float_t> cholesky;
+  kernel_function_t kernel;
+
+  void Factorize(svm_float_t);
+
+ public:
+  // 直接以[first, first + Components)作为地标
+  template <std::forward_iterator forwardIt>
+  NystroemFeature(forwardIt, const kernel_function_t&,
+                  svm_float_t Jitter = 1e-10);
+  // 从[first, last)中随机抽取Components个地标
+  template <std::forward_iterator forwardIt>
+  NystroemFeature(forwardIt, forwardIt, const kernel_function_t&,
+                  std::size_t seed = 0, svm_float_t Jitter = 1e-10);
+
+  output_t operator()(const input_t&) const;
+  output_sample_t operator()(const input_sample_t&) const;
+};
+
+}  // namespace SVM
+
+//////////implementation//////////
+
+namespace SVM {
+
+template <std::size_t Dimension, std::size_t Components,
+          std::floating_point svm_float_t>
+template <std::forward_iterator forwardIt>
+NystroemFeature<Dimension, Components, svm_float_t>::NystroemFeature(
+    forwardIt first, const kernel_function_t& _kernel, svm_float_t Jitter)
+    : kernel(_kernel) {
+  for (auto& l : landmark) l = (*first++).data;
+  Factorize(Jitter);
+}
+
+template <std::size_t Dimension, std::size_t Components,
+          std::floating_point svm_float_t>
+template <std::forward_iterator forwardIt>
+NystroemFeature<Dimension, Components, svm_float_t>::NystroemFeature(
+    forwardIt first, forwardIt last, const kernel_function_t& _kernel,
+    std::size_t seed, svm_float_t Jitter)
+    : kernel(_kernel) {
+  std::mt19937_64 Engine(seed);
+  std::vector<Sample<Dimension, svm_float_t>> chosen;
+  chosen.reserve(Components);
+  std::sample(first, last, std::back_inserter(chosen), Components, Engine);
+  if (chosen.size() != Components)
+    throw std::runtime_error("Not enough samples for Nystroem landmarks.");
+  for (std::size_t i = 0; i < Components; i++) landmark[i] = chosen[i].data;
+  Factorize(Jitter);
+}
+
+template <std::size_t Dimension, std::size_t Components,
+          std::floating_point svm_float_t>
+void NystroemFeature<Dimension, Components, svm_float_t>::Factorize(
+    svm_float_t Jitter) {
+  cholesky.assign(Components * Components, 0);
+  auto L = [&](std::size_t i, std::size_t j) -> svm_float_t& {
+    return cholesky[i * Components + j];
+  };
+  for (std::size_t i = 0; i < Components; i++)
+    for (std::size_t j = 0; j <= i; j++) {
+      svm_float_t s = kernel(landmark[i], landmark[j]);
+      for (std::size_t k = 0; k < j; k++) s -= L(i, k) * L(j, k);
+      if (i == j)
+        // 地标重复或核矩阵退化时由Jitter保证正定
+        L(i, i) = std::sqrt(std::max(s, svm_float_t(0)) + Jitter);
+      else
+        L(i, j) = s / L(j, j);
+    }
+}
+
+template <std::size_t Dimension, std::size_t Components,
+          std::floating_point svm_float_t>
+typename NystroemFeature<Dimension, Components, svm_float_t>::output_t
+NystroemFeature<Dimension, Components, svm_float_t>::operator()(
+    const input_t& data) const {
+  output_t result;
+  // 前代求解 L * result = k(x)
+  for (std::size_t i = 0; i < Components; i++) {
+    svm_float_t s = kernel(data, landmark[i]);
+    for (std::size_t k = 0; k < i; k++)
+      s -= cholesky[i * Components + k] * result[k];
+    result[i] = s / cholesky[i * Components + i];
+  }
+  return result;
+}
+
+template <std::size_t Dimension, std::size_t Components,
+          std::floating_point svm_float_t>
+typename NystroemFeature<Dimension, Components, svm_float_t>::output_sample_t
+NystroemFeature<Dimension, Components, svm_float_t>::operator()(
+    const input_sample_t& sample) const {
+  return {sample.classification, (*this)(sample.data)};
+}
+
+}  // namespace SVM
+
+#endif
\ No newline at end of file
@@ -0,0 +1,84 @@
+#ifndef __SVM_RANDOM_FOURIER_FEATURE_HPP__
+#define __SVM_RANDOM_FOURIER_FEATURE_HPP__
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <numbers>
+#include <random>
+
+#include "Sample/Sample.hpp"
+#include "common/common.hpp"
+
+namespace SVM {
+
+// 随机傅里叶特征，近似RBF核 exp(-|a-b|^2 / Width)
+// 映射后的向量内积即为核函数的无偏估计，Components越大越精确
+template <std::size_t _Dimension, std::size_t _Components,
+          std::floating_point svm_float_t = double>
+class RandomFourierFeature {
+ public:
+  static constexpr std::size_t Dimension = _Dimension;
+  static constexpr std::size_t Components = _Components;
+  using value_type = svm_float_t;
+  using input_t = FixedVector<Dimension, svm_float_t>;
+  using output_t = FixedVector<Components, svm_float_t>;
+  using input_sample_t = Sample<Dimension, svm_float_t>;
+  using output_sample_t = Sample<Components, svm_float_t>;
+
+ private:
+  std::array<input_t, Components> omega;
+  output_t offset;
+
+ public:
+  explicit RandomFourierFeature(svm_float_t Width, std::size_t seed = 0);
+
+  output_t operator()(const input_t&) const;
+  output_sample_t operator()(const input_sample_t&) const;
+};
+
+}  // namespace SVM
+
+//////////implementation//////////
+
+namespace SVM {
+
+template <std::size_t Dimension, std::size_t Components,
+          std::floating_point svm_float_t>
+RandomFourierFeature<Dimension, Components, svm_float_t>::RandomFourierFeature(
+    svm_float_t Width, std::size_t seed) {
+  std::mt19937_64 Engine(seed);
+  // exp(-|d|^2 / Width)的傅里叶变换为方差2/Width的正态分布
+  std::normal_distribution<svm_float_t> OmegaDistribution(
+      0, std::sqrt(2 / Width));
+  std::uniform_real_distribution<svm_float_t> OffsetDistribution(
+      0, 2 * std::numbers::pi_v<svm_float_t>);
+  for (auto& w : omega)
+    std::ranges::generate(w, [&] { return OmegaDistribution(Engine); });
+  std::ranges::generate(offset, [&] { return OffsetDistribution(Engine); });
+}
+
+template <std::size_t Dimension, std::size_t Components,
+          std::floating_point svm_float_t>
+typename RandomFourierFeature<Dimension, Components, svm_float_t>::output_t
+RandomFourierFeature<Dimension, Components, svm_float_t>::operator()(
+    const input_t& data) const {
+  const svm_float_t scale = std::sqrt(svm_float_t(2) / Components);
+  output_t result;
+  for (std::size_t i = 0; i < Components; i++)
+    result[i] = scale * std::cos(omega[i].dot(data) + offset[i]);
+  return result;
+}
+
+template <std::size_t Dimension, std::size_t Components,
+          std::floating_point svm_float_t>
+typename RandomFourierFeature<Dimension, Components, svm_float_t>::output_sample_t
+RandomFourierFeature<Dimension, Components, svm_float_t>::operator()(
+    const input_sample_t& sample) const {
+  return {sample.classification, (*this)(sample.data)};
+}
+
+}  // namespace SVM
+
+#endif
\ No newline at end of file
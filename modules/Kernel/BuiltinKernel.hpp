@@ -0,0 +1,45 @@
+#ifndef __SVM_BUILTIN_KERNEL_HPP__
+#define __SVM_BUILTIN_KERNEL_HPP__
+
+#include <cstddef>
+
+#include "Kernel/LinearKernel.hpp"
+#include "Kernel/PolynomialKernel.hpp"
+#include "Kernel/RBFKernel.hpp"
+#include "Kernel/SigmoidKernel.hpp"
+#include "common/common.hpp"
+
+namespace SVM {
+
+// kernel为包装了内置核的std::function时，以具体的核类型调用visitor并返回true
+template <std::size_t Dimension, std::floating_point svm_float_t,
+          class kernel_function_t, class Visitor>
+bool VisitBuiltinKernel(const kernel_function_t& kernel,
+                        const Visitor& visitor) {
+  auto visit =
+      [&]<template <std::size_t, std::floating_point> class Kernel>() {
+        const auto* builtin =
+            kernel.template target<Kernel<Dimension, svm_float_t>>();
+        if (builtin) visitor(*builtin);
+        return builtin != nullptr;
+      };
+  return visit.template operator()<RBFKernel>() ||
+         visit.template operator()<SigmoidKernel>() ||
+         visit.template operator()<PolynomialKernel>() ||
+         visit.template operator()<LinearKernel>();
+}
+
+// 调用kernel时可用的线程数：内置核为Threads，自定义核为1，不要求其线程安全
+template <std::size_t Dimension, std::floating_point svm_float_t,
+          class kernel_function_t>
+std::size_t KernelThreads(const kernel_function_t& kernel,
+                          std::size_t Threads) {
+  return VisitBuiltinKernel<Dimension, svm_float_t>(kernel,
+                                                    [](const auto&) {})
+             ? Threads
+             : 1;
+}
+
+}  // namespace SVM
+
+#endif
\ No newline at end of file
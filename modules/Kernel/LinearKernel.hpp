@@ -0,0 +1,32 @@
+#ifndef __SVM_LINEAR_KERNEL_HPP__
+#define __SVM_LINEAR_KERNEL_HPP__
+
+#include <cstddef>
+#include <iterator>
+
+#include "common/common.hpp"
+
+namespace SVM {
+
+// 线性核 a.b
+template <std::size_t Dimension, std::floating_point svm_float_t = double>
+struct LinearKernel {
+  svm_float_t operator()(const FixedVector<Dimension, svm_float_t>& a,
+                         const FixedVector<Dimension, svm_float_t>& b) const {
+    return a.dot(b);
+  }
+  // 由内积与两向量的模长平方求核函数值
+  svm_float_t FromDot(svm_float_t dot, svm_float_t, svm_float_t) const {
+    return dot;
+  }
+  // 求a与[first, last)中各向量的核函数值，依次写入output
+  template <std::random_access_iterator randomIt>
+  void Row(const FixedVector<Dimension, svm_float_t>& a, randomIt first,
+           randomIt last, svm_float_t* output) const {
+    for (; first != last; ++first) *output++ = a.dot(*first);
+  }
+};
+
+}  // namespace SVM
+
+#endif
\ No newline at end of file
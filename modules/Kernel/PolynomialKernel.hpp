@@ -0,0 +1,38 @@
+#ifndef __SVM_POLYNOMIAL_KERNEL_HPP__
+#define __SVM_POLYNOMIAL_KERNEL_HPP__
+
+#include <cstddef>
+#include <iterator>
+
+#include "common/common.hpp"
+
+namespace SVM {
+
+// 多项式核 (Scale * a.b + Coef0)^Degree
+template <std::size_t Dimension, std::floating_point svm_float_t = double>
+struct PolynomialKernel {
+  std::size_t Degree;
+  svm_float_t Scale = 1, Coef0 = 0;
+
+  svm_float_t operator()(const FixedVector<Dimension, svm_float_t>& a,
+                         const FixedVector<Dimension, svm_float_t>& b) const {
+    return FromDot(a.dot(b), 0, 0);
+  }
+  // 由内积与两向量的模长平方求核函数值
+  svm_float_t FromDot(svm_float_t dot, svm_float_t, svm_float_t) const {
+    const svm_float_t base = Scale * dot + Coef0;
+    svm_float_t result = 1;
+    for (std::size_t k = 0; k < Degree; k++) result *= base;
+    return result;
+  }
+  // 求a与[first, last)中各向量的核函数值，依次写入output
+  template <std::random_access_iterator randomIt>
+  void Row(const FixedVector<Dimension, svm_float_t>& a, randomIt first,
+           randomIt last, svm_float_t* output) const {
+    for (; first != last; ++first) *output++ = (*this)(a, *first);
+  }
+};
+
+}  // namespace SVM
+
+#endif
\ No newline at end of file
@@ -0,0 +1,45 @@
+#ifndef __SVM_RBF_KERNEL_HPP__
+#define __SVM_RBF_KERNEL_HPP__
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+
+#include "common/FastMath.hpp"
+#include "common/common.hpp"
+
+namespace SVM {
+
+// RBF核 exp(-|a-b|^2 / Width)
+// Accuracy为Row中批量计算exp的精度，逐个求值时使用std::exp
+template <std::size_t Dimension, std::floating_point svm_float_t = double>
+struct RBFKernel {
+  svm_float_t Width;
+  FastMathAccuracy Accuracy = FastMathAccuracy::High;
+
+  svm_float_t operator()(const FixedVector<Dimension, svm_float_t>& a,
+                         const FixedVector<Dimension, svm_float_t>& b) const {
+    return std::exp(-a.squared_distance(b) / Width);
+  }
+  // 由内积与两向量的模长平方求核函数值
+  svm_float_t FromDot(svm_float_t dot, svm_float_t norm_a,
+                      svm_float_t norm_b) const {
+    return std::exp(-std::max(norm_a + norm_b - 2 * dot, svm_float_t(0)) /
+                    Width);
+  }
+  // 求a与[first, last)中各向量的核函数值，依次写入output
+  // 先求出整行指数再以FastExp向量化计算
+  template <std::random_access_iterator randomIt>
+  void Row(const FixedVector<Dimension, svm_float_t>& a, randomIt first,
+           randomIt last, svm_float_t* output) const {
+    const std::size_t n = last - first;
+    for (std::size_t i = 0; i < n; i++)
+      output[i] = -a.squared_distance(first[i]) / Width;
+    FastExp(output, n, Accuracy);
+  }
+};
+
+}  // namespace SVM
+
+#endif
\ No newline at end of file
@@ -0,0 +1,42 @@
+#ifndef __SVM_SIGMOID_KERNEL_HPP__
+#define __SVM_SIGMOID_KERNEL_HPP__
+
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+
+#include "common/FastMath.hpp"
+#include "common/common.hpp"
+
+namespace SVM {
+
+// Sigmoid核 tanh(Scale * a.b + Coef0)
+// Accuracy为Row中批量计算tanh的精度，逐个求值时使用std::tanh
+template <std::size_t Dimension, std::floating_point svm_float_t = double>
+struct SigmoidKernel {
+  svm_float_t Scale = 1, Coef0 = 0;
+  FastMathAccuracy Accuracy = FastMathAccuracy::High;
+
+  svm_float_t operator()(const FixedVector<Dimension, svm_float_t>& a,
+                         const FixedVector<Dimension, svm_float_t>& b) const {
+    return FromDot(a.dot(b), 0, 0);
+  }
+  // 由内积与两向量的模长平方求核函数值
+  svm_float_t FromDot(svm_float_t dot, svm_float_t, svm_float_t) const {
+    return std::tanh(Scale * dot + Coef0);
+  }
+  // 求a与[first, last)中各向量的核函数值，依次写入output
+  // 先求出整行参数再以FastTanh向量化计算
+  template <std::random_access_iterator randomIt>
+  void Row(const FixedVector<Dimension, svm_float_t>& a, randomIt first,
+           randomIt last, svm_float_t* output) const {
+    const std::size_t n = last - first;
+    for (std::size_t i = 0; i < n; i++)
+      output[i] = Scale * a.dot(first[i]) + Coef0;
+    FastTanh(output, n, Accuracy);
+  }
+};
+
+}  // namespace SVM
+
+#endif
\ No newline at end of file
@@ -0,0 +1,150 @@
+#ifndef __SVM_KERNEL_MATRIX_HPP__
+#define __SVM_KERNEL_MATRIX_HPP__
+
+#include <sys/mman.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <new>
+#include <utility>
+
+#include "common/Parallel.hpp"
+#include "common/common.hpp"
+
+namespace SVM {
+
+enum class HugePagePolicy {
+  None,         // 普通页
+  Transparent,  // madvise(MADV_HUGEPAGE)请求透明大页
+  Explicit      // MAP_HUGETLB预留大页，失败时回退到Transparent
+};
+
+// 对称核矩阵的存储，按TileSize x TileSize分块存储下三角
+// 下标均为64位，块按缓存行对齐，整体按2MiB对齐以便使用大页
+template <std::floating_point svm_float_t = double, std::size_t TileSize = 32>
+class KernelMatrix {
+  static_assert(TileSize * TileSize * sizeof(svm_float_t) % 64 == 0);
+  static constexpr std::size_t HugePageSize = std::size_t(1) << 21;
+  static constexpr std::size_t TileElements = TileSize * TileSize;
+
+  std::size_t n = 0;
+  std::size_t bytes = 0;
+  svm_float_t* content = nullptr;
+
+  static constexpr std::size_t Tiles(std::size_t size) {
+    std::size_t t = (size + TileSize - 1) / TileSize;
+    return t * (t + 1) / 2;
+  }
+
+ public:
+  // 存储n阶核矩阵所需字节数，用于与MaxMemUsage比较
+  static constexpr std::size_t Bytes(std::size_t size) {
+    return Tiles(size) * TileElements * sizeof(svm_float_t);
+  }
+
+  explicit KernelMatrix(std::size_t,
+                        HugePagePolicy = HugePagePolicy::Transparent);
+  KernelMatrix(const KernelMatrix&) = delete;
+  KernelMatrix& operator=(const KernelMatrix&) = delete;
+  KernelMatrix(KernelMatrix&& other) noexcept
+      : n(std::exchange(other.n, 0)),
+        bytes(std::exchange(other.bytes, 0)),
+        content(std::exchange(other.content, nullptr)) {}
+  ~KernelMatrix();
+
+  std::size_t Size() const { return n; }
+
+  svm_float_t& operator()(std::size_t i, std::size_t j) {
+    if (i < j) std::swap(i, j);
+    const std::size_t I = i / TileSize, J = j / TileSize;
+    return content[(I * (I + 1) / 2 + J) * TileElements +
+                   i % TileSize * TileSize + j % TileSize];
+  }
+  const svm_float_t& operator()(std::size_t i, std::size_t j) const {
+    return const_cast<KernelMatrix&>(*this)(i, j);
+  }
+
+  // 并行填充kernel(i, j)，页面由首次写入的线程分配，多线程训练时即为NUMA本地
+  template <class Func>
+  void Fill(const Func&, std::size_t Threads = DefaultThreads());
+  // 同Fill，以kernel.Row(first[i], ...)按块内连续的行段批量计算
+  // first[i]为第i个样本的数据
+  template <std::random_access_iterator randomIt, class Kernel>
+  void FillRows(randomIt first, const Kernel&,
+                std::size_t Threads = DefaultThreads());
+};
+
+}  // namespace SVM
+
+//////////implementation//////////
+
+namespace SVM {
+
+template <std::floating_point svm_float_t, std::size_t TileSize>
+KernelMatrix<svm_float_t, TileSize>::KernelMatrix(std::size_t size,
+                                                  HugePagePolicy policy)
+    : n(size) {
+  bytes = (Bytes(n) + HugePageSize - 1) / HugePageSize * HugePageSize;
+  if (bytes == 0) return;
+  void* p = MAP_FAILED;
+  if (policy == HugePagePolicy::Explicit)
+    p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+               MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+  if (p == MAP_FAILED) {
+    p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+               MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED) throw std::bad_alloc();
+    if (policy != HugePagePolicy::None) ::madvise(p, bytes, MADV_HUGEPAGE);
+  }
+  content = static_cast<svm_float_t*>(p);
+}
+
+template <std::floating_point svm_float_t, std::size_t TileSize>
+KernelMatrix<svm_float_t, TileSize>::~KernelMatrix() {
+  if (content) ::munmap(content, bytes);
+}
+
+template <std::floating_point svm_float_t, std::size_t TileSize>
+template <class Func>
+void KernelMatrix<svm_float_t, TileSize>::Fill(const Func& kernel,
+                                               std::size_t Threads) {
+  const std::size_t rows = (n + TileSize - 1) / TileSize;
+  // 以块行为单位分配，块行内的块在内存中连续
+  ParallelFor(
+      rows,
+      [&](std::size_t I) {
+        const std::size_t last = std::min(n, (I + 1) * TileSize);
+        for (std::size_t J = 0; J <= I; J++)
+          for (std::size_t i = I * TileSize; i < last; i++)
+            for (std::size_t j = J * TileSize;
+                 j < std::min(i + 1, (J + 1) * TileSize); j++)
+              (*this)(i, j) = kernel(i, j);
+      },
+      Threads);
+}
+
+template <std::floating_point svm_float_t, std::size_t TileSize>
+template <std::random_access_iterator randomIt, class Kernel>
+void KernelMatrix<svm_float_t, TileSize>::FillRows(randomIt first,
+                                                   const Kernel& kernel,
+                                                   std::size_t Threads) {
+  const std::size_t rows = (n + TileSize - 1) / TileSize;
+  ParallelFor(
+      rows,
+      [&](std::size_t I) {
+        const std::size_t last = std::min(n, (I + 1) * TileSize);
+        for (std::size_t J = 0; J <= I; J++)
+          for (std::size_t i = I * TileSize; i < last; i++) {
+            const std::size_t j = J * TileSize;
+            const std::size_t end = std::min(i + 1, j + TileSize);
+            kernel.Row(first[i], first + j, first + end, &(*this)(i, j));
+          }
+      },
+      Threads);
+}
+
+}  // namespace SVM
+
+#endif
\ No newline at end of file
@@ -0,0 +1,200 @@
+#ifndef __SVM_NORMALIZER_HPP__
+#define __SVM_NORMALIZER_HPP__
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "SVM/SVM.hpp"
+#include "common/Parallel.hpp"
+#include "common/common.hpp"
+
+namespace SVM {
+
+enum class NormalizeMode {
+  MinMax,  // 映射到[0, 1]
+  ZScore   // 减去均值后除以标准差
+};
+
+// 逐维仿射变换 x'_d = x_d * scale_d + offset_d
+// 拟合后与模型一同保存，推理时对原始特征使用同一变换
+template <std::size_t Dimension, std::floating_point svm_float_t = double>
+struct Normalizer {
+  using data_t = FixedVector<Dimension, svm_float_t>;
+
+  data_t scale, offset;
+
+  // 默认为恒等变换
+  Normalizer();
+
+  // 在[first, last)上分块并行拟合变换，取值恒定的维度只做平移
+  template <std::random_access_iterator randomIt>
+  static Normalizer Fit(randomIt first, randomIt last,
+                        NormalizeMode = NormalizeMode::MinMax,
+                        std::size_t Threads = DefaultThreads());
+
+  data_t operator()(const data_t&) const;
+  // 原地变换[first, last)中的样本
+  template <std::forward_iterator forwardIt>
+  void Apply(forwardIt first, forwardIt last) const;
+  // 将变换并入线性模型，得到直接作用于原始特征的等价模型
+  LinearSVM<Dimension, svm_float_t> Fold(
+      const LinearSVM<Dimension, svm_float_t>&) const;
+
+  // 二进制读写
+  void Save(std::ostream&) const;
+  static Normalizer Load(std::istream&);
+};
+
+struct NormalizerHeader {
+  char magic[8] = {'S', 'V', 'M', 'N', 'O', 'R', 'M', '\0'};
+  uint64_t dimension = 0;
+  uint64_t float_size = 0;
+};
+
+}  // namespace SVM
+
+//////////implementation//////////
+
+namespace SVM {
+
+template <std::size_t Dimension, std::floating_point svm_float_t>
+Normalizer<Dimension, svm_float_t>::Normalizer() {
+  for (std::size_t d = 0; d < Dimension; d++) {
+    scale[d] = 1;
+    offset[d] = 0;
+  }
+}
+
+template <std::size_t Dimension, std::floating_point svm_float_t>
+template <std::random_access_iterator randomIt>
+Normalizer<Dimension, svm_float_t> Normalizer<Dimension, svm_float_t>::Fit(
+    randomIt first, randomIt last, NormalizeMode mode, std::size_t Threads) {
+  const std::size_t n = last - first;
+  if (n == 0) throw std::runtime_error("Fail to fit normalizer on no sample.");
+  Threads = std::max<std::size_t>(1, std::min(Threads, n));
+
+  // 每块统计最小最大值，或样本数、均值与离差平方和
+  struct Statistic {
+    std::size_t count = 0;
+    data_t low, high, mean, m2;
+  };
+  std::vector<Statistic> part(Threads);
+  ParallelFor(
+      Threads,
+      [&](std::size_t t) {
+        Statistic& s = part[t];
+        for (std::size_t d = 0; d < Dimension; d++) {
+          s.low[d] = std::numeric_limits<svm_float_t>::max();
+          s.high[d] = std::numeric_limits<svm_float_t>::lowest();
+          s.mean[d] = s.m2[d] = 0;
+        }
+        for (std::size_t i = n * t / Threads; i < n * (t + 1) / Threads;
+             i++) {
+          const auto& x = (*(first + i)).data;
+          s.count++;
+          for (std::size_t d = 0; d < Dimension; d++) {
+            s.low[d] = std::min(s.low[d], x[d]);
+            s.high[d] = std::max(s.high[d], x[d]);
+            const svm_float_t delta = x[d] - s.mean[d];
+            s.mean[d] += delta / s.count;
+            s.m2[d] += delta * (x[d] - s.mean[d]);
+          }
+        }
+      },
+      Threads);
+
+  // 合并各块统计量(Chan等人的并行方差公式)
+  Statistic all = part[0];
+  for (std::size_t t = 1; t < Threads; t++) {
+    const Statistic& s = part[t];
+    if (s.count == 0) continue;
+    const std::size_t count = all.count + s.count;
+    for (std::size_t d = 0; d < Dimension; d++) {
+      all.low[d] = std::min(all.low[d], s.low[d]);
+      all.high[d] = std::max(all.high[d], s.high[d]);
+      const svm_float_t delta = s.mean[d] - all.mean[d];
+      all.mean[d] += delta * s.count / count;
+      all.m2[d] += s.m2[d] + delta * delta * all.count * s.count / count;
+    }
+    all.count = count;
+  }
+
+  Normalizer normalizer;
+  for (std::size_t d = 0; d < Dimension; d++) {
+    const svm_float_t shift =
+        mode == NormalizeMode::MinMax ? all.low[d] : all.mean[d];
+    const svm_float_t range = mode == NormalizeMode::MinMax
+                                  ? all.high[d] - all.low[d]
+                                  : std::sqrt(all.m2[d] / all.count);
+    normalizer.scale[d] = range > 0 ? 1 / range : 1;
+    normalizer.offset[d] = -shift * normalizer.scale[d];
+  }
+  return normalizer;
+}
+
+template <std::size_t Dimension, std::floating_point svm_float_t>
+auto Normalizer<Dimension, svm_float_t>::operator()(const data_t& x) const
+    -> data_t {
+  data_t result;
+  for (std::size_t d = 0; d < Dimension; d++)
+    result[d] = x[d] * scale[d] + offset[d];
+  return result;
+}
+
+template <std::size_t Dimension, std::floating_point svm_float_t>
+template <std::forward_iterator forwardIt>
+void Normalizer<Dimension, svm_float_t>::Apply(forwardIt first,
+                                               forwardIt last) const {
+  for (; first != last; ++first) (*first).data = (*this)((*first).data);
+}
+
+// w.(x * s + o) + b = (w * s).x + (w.o + b)
+template <std::size_t Dimension, std::floating_point svm_float_t>
+LinearSVM<Dimension, svm_float_t> Normalizer<Dimension, svm_float_t>::Fold(
+    const LinearSVM<Dimension, svm_float_t>& svm) const {
+  SegmentPlane<Dimension, svm_float_t> plane = svm.segmentation;
+  plane.bias += plane.weight.dot(offset);
+  for (std::size_t d = 0; d < Dimension; d++) plane.weight[d] *= scale[d];
+  return LinearSVM<Dimension, svm_float_t>(plane);
+}
+
+template <std::size_t Dimension, std::floating_point svm_float_t>
+void Normalizer<Dimension, svm_float_t>::Save(std::ostream& os) const {
+  NormalizerHeader header;
+  header.dimension = Dimension;
+  header.float_size = sizeof(svm_float_t);
+  os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  for (const data_t* v : {&scale, &offset})
+    for (const auto& x : *v)
+      os.write(reinterpret_cast<const char*>(&x), sizeof(svm_float_t));
+  if (!os) throw std::runtime_error("Fail to write normalizer.");
+}
+
+template <std::size_t Dimension, std::floating_point svm_float_t>
+Normalizer<Dimension, svm_float_t> Normalizer<Dimension, svm_float_t>::Load(
+    std::istream& is) {
+  NormalizerHeader header;
+  is.read(reinterpret_cast<char*>(&header), sizeof(header));
+  if (!is || std::memcmp(header.magic, NormalizerHeader().magic, 8) != 0 ||
+      header.dimension != Dimension ||
+      header.float_size != sizeof(svm_float_t))
+    throw std::runtime_error("Mismatched normalizer.");
+  Normalizer normalizer;
+  for (data_t* v : {&normalizer.scale, &normalizer.offset})
+    for (auto& x : *v)
+      is.read(reinterpret_cast<char*>(&x), sizeof(svm_float_t));
+  if (!is) throw std::runtime_error("Fail to read normalizer.");
+  return normalizer;
+}
+
+}  // namespace SVM
+
+#endif
\ No newline at end of file
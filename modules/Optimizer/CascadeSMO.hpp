@@ -0,0 +1,208 @@
+#ifndef __SVM_CASCADE_SMO_HPP__
+#define __SVM_CASCADE_SMO_HPP__
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "Kernel/BuiltinKernel.hpp"
+#include "KernelMatrix/KernelMatrix.hpp"
+#include "Optimizer/SMO.hpp"
+#include "SVM/SVM.hpp"
+#include "Sample/Sample.hpp"
+#include "common/Parallel.hpp"
+#include "common/common.hpp"
+
+namespace SVM {
+
+// 反馈阶段判定违反KKT条件的间隔容差
+const double CascadeKKTEps = 1e-3;
+
+// 级联SVM：将数据集划分为Partitions份并行训练，逐层两两合并支持向量后重新训练
+// FeedbackLimit > 0时将最终支持向量反馈回各划分重新级联，直到全局满足KKT条件
+// Threads只用于内置核，自定义核总在调用线程上串行计算，不要求其线程安全
+// 其余参数含义同SMO，LevelCallback报告已完成的层数
+template <std::size_t Dimension, std::floating_point svm_float_t = double,
+          std::forward_iterator forwardIt>
+CompactSVM<Dimension, svm_float_t> CascadeSMO(
+    forwardIt first, forwardIt last,
+    const typename CompactSVM<Dimension, svm_float_t>::kernel_function_t&
+        kernel,
+    svm_float_t Tolerance, std::size_t EpochLimit, svm_float_t ModifyLimit,
+    std::size_t Partitions, std::size_t FeedbackLimit = 0, std::size_t seed = 0,
+    std::size_t Threads = DefaultThreads(),
+    const DataCallback<std::size_t>& LevelCallback = [](std::size_t) {});
+
+}  // namespace SVM
+
+//////////implementation//////////
+
+namespace SVM {
+
+template <std::size_t Dimension, std::floating_point svm_float_t,
+          std::forward_iterator forwardIt>
+CompactSVM<Dimension, svm_float_t> CascadeSMO(
+    forwardIt first, forwardIt last,
+    const typename CompactSVM<Dimension, svm_float_t>::kernel_function_t&
+        kernel,
+    svm_float_t Tolerance, std::size_t EpochLimit, svm_float_t ModifyLimit,
+    std::size_t Partitions, std::size_t FeedbackLimit, std::size_t seed,
+    std::size_t Threads, const DataCallback<std::size_t>& LevelCallback) {
+  using sample_t = Sample<Dimension, svm_float_t>;
+  // 子问题：样本下标及对应lambda
+  struct Working {
+    std::vector<std::size_t> index;
+    std::vector<svm_float_t> lambda;
+    svm_float_t bias = 0;
+  };
+
+  const std::vector<sample_t> sample(first, last);
+  const std::size_t N = sample.size();
+  if (N == 0) throw std::runtime_error("Fail to train on no sample.");
+  Partitions = std::clamp<std::size_t>(Partitions, 1, N);
+  // 各子问题的求解与反馈检查都会调用kernel
+  Threads = KernelThreads<Dimension, svm_float_t>(kernel, Threads);
+
+  auto solve = [&](Working& w) {
+    const std::size_t n = w.index.size();
+    auto label = [&](std::size_t i) {
+      return sample[w.index[i]].classification;
+    };
+    auto raw_kernel = [&](std::size_t i, std::size_t j) {
+      return kernel(sample[w.index[i]].data, sample[w.index[j]].data);
+    };
+    // 子问题的核矩阵在预算内时预处理出运算结果，由本线程填充以保证NUMA本地
+    std::span<svm_float_t> lambda(w.lambda);
+    if (KernelMatrix<svm_float_t>::Bytes(n) <= MaxMemUsage) {
+      KernelMatrix<svm_float_t> kernel_save(n);
+      kernel_save.Fill(raw_kernel, 1);
+      w.bias = SMOSolve(label, kernel_save, lambda, Tolerance, EpochLimit,
+                        ModifyLimit);
+    } else
+      w.bias = SMOSolve(label, raw_kernel, lambda, Tolerance, EpochLimit,
+                        ModifyLimit);
+    // 只保留支持向量进入下一层
+    Working sv;
+    for (std::size_t i = 0; i < n; i++)
+      if (sgn(w.lambda[i]) != 0) {
+        sv.index.push_back(w.index[i]);
+        sv.lambda.push_back(w.lambda[i]);
+      }
+    sv.bias = w.bias;
+    w = std::move(sv);
+  };
+
+  using entry_t = std::pair<std::size_t, svm_float_t>;
+  auto merge = [&](const Working& a, const Working& b) {
+    std::vector<entry_t> all;
+    all.reserve(a.index.size() + b.index.size());
+    for (std::size_t i = 0; i < a.index.size(); i++)
+      all.emplace_back(a.index[i], a.lambda[i]);
+    for (std::size_t i = 0; i < b.index.size(); i++)
+      all.emplace_back(b.index[i], b.lambda[i]);
+    std::ranges::stable_sort(all, {}, &entry_t::first);
+    auto [dup_first, dup_last] = std::ranges::unique(all, {}, &entry_t::first);
+    all.erase(dup_first, dup_last);
+
+    Working w;
+    for (auto& [i, l] : all) {
+      w.index.push_back(i);
+      w.lambda.push_back(l);
+    }
+    // 反馈阶段存在重复样本，去重后重新满足sum(lambda_i * y_i) = 0
+    svm_float_t residual = 0;
+    for (std::size_t i = 0; i < w.index.size(); i++)
+      residual += w.lambda[i] * sample[w.index[i]].classification;
+    if (!w.index.empty())
+      w.lambda[0] -= residual * sample[w.index[0]].classification;
+    return w;
+  };
+
+  // 初始划分
+  std::vector<std::size_t> order(N);
+  std::iota(order.begin(), order.end(), 0);
+  std::ranges::shuffle(order, std::mt19937(seed));
+  std::vector<std::vector<std::size_t>> partition(Partitions);
+  for (std::size_t i = 0; i < N; i++)
+    partition[i * Partitions / N].push_back(order[i]);
+
+  std::vector<Working> level(Partitions);
+  for (std::size_t p = 0; p < Partitions; p++) {
+    Working& w = level[p];
+    w.index = partition[p];
+    w.lambda.resize(partition[p].size());
+    SMOInitLambda(
+        [&](std::size_t i) { return sample[w.index[i]].classification; },
+        std::span<svm_float_t>(w.lambda), seed + p);
+  }
+
+  CompactSVM<Dimension, svm_float_t> result(kernel);
+  for (std::size_t feedback = 0;; feedback++) {
+    std::size_t depth = 0;
+    ParallelFor(
+        level.size(), [&](std::size_t p) { solve(level[p]); }, Threads);
+    LevelCallback(depth++);
+    while (level.size() > 1) {
+      std::vector<Working> next((level.size() + 1) / 2);
+      ParallelFor(
+          next.size(),
+          [&](std::size_t k) {
+            if (2 * k + 1 == level.size()) {
+              next[k] = std::move(level[2 * k]);
+              return;
+            }
+            next[k] = merge(level[2 * k], level[2 * k + 1]);
+            solve(next[k]);
+          },
+          Threads);
+      level = std::move(next);
+      LevelCallback(depth++);
+    }
+
+    Working& final_level = level.front();
+    result.support.clear();
+    result.lambda = final_level.lambda;
+    result.bias = final_level.bias;
+    for (auto i : final_level.index) result.support.push_back(sample[i]);
+    if (feedback == FeedbackLimit) break;
+
+    // 检查非支持向量是否满足 y * f(x) >= 1
+    std::vector<char> is_support(N, 0);
+    for (auto i : final_level.index) is_support[i] = 1;
+    std::vector<char> violate(N, 0);
+    ParallelFor(
+        N,
+        [&](std::size_t i) {
+          if (is_support[i]) return;
+          const auto& [y, x] = sample[i];
+          violate[i] = y * result.Decision(x) < 1 - CascadeKKTEps;
+        },
+        Threads);
+    if (std::ranges::find(violate, 1) == violate.end()) break;
+
+    // 将最终支持向量反馈回每个初始划分
+    std::vector<Working> feedback_level(Partitions);
+    for (std::size_t p = 0; p < Partitions; p++) {
+      Working& w = feedback_level[p];
+      w.index = final_level.index;
+      w.lambda = final_level.lambda;
+      for (auto i : partition[p])
+        if (!is_support[i]) {
+          w.index.push_back(i);
+          w.lambda.push_back(0);
+        }
+    }
+    level = std::move(feedback_level);
+  }
+  return result;
+}
+
+}  // namespace SVM
+
+#endif
\ No newline at end of file
@@ -27,20 +27,20 @@ void LinearSMO(SVM<DataSetSize, Dimension, svm_float_t>& svm,
 
   std::ranges::generate(svm.lambda,
                         [&]() { return LambdaDistribution(engine); });
-  svm.lambda[0] += -std::transform_reduce(
+  const svm_float_t residual = std::transform_reduce(
       svm.sample.begin(), svm.sample.end(), svm.lambda.begin(), svm_float_t(0),
       std::plus<>{},
       [](const Sample<Dimension, svm_float_t>& v, const svm_float_t& L) {
         return L * v.classification;
       });
+  // 修正量乘以y_0，使y_0 = -1时sum(lambda_i * y_i) = 0同样成立
+  svm.lambda[0] += -residual * svm.sample[0].classification;
 
   // 合并所有x_i到sum
-  vector_t sum = std::transform_reduce(
-      svm.sample.begin(), svm.sample.end(), svm.lambda.begin(), vector_t(),
-      std::plus<>{},
-      [](const Sample<Dimension, svm_float_t>& v, const svm_float_t& L) {
-        return v.data * (L * v.classification);
-      });
+  vector_t sum{};
+  for (std::size_t i = 0; i < DataSetSize; i++)
+    sum.axpy(svm.lambda[i] * svm.sample[i].classification,
+             svm.sample[i].data);
 
   for (std::size_t epoch = 0; epoch != EpochLimit; epoch++) {
     svm_float_t modify = 0;
@@ -53,26 +53,27 @@ void LinearSMO(SVM<DataSetSize, Dimension, svm_float_t>& svm,
         const auto& [y_i, x_i] = svm.sample[i];
         const auto& [y_j, x_j] = svm.sample[j];
 
-        vector_t tsum = sum - x_i * L_i * y_i - x_j * L_j * y_j;
+        // 样本权重使各lambda的上界不同
+        const svm_float_t C_i = Tolerance * svm.weight[i],
+                          C_j = Tolerance * svm.weight[j];
         svm_float_t L_j_low =
-            y_i == y_j ? std::max(svm_float_t(0), L_i + L_j - Tolerance)
+            y_i == y_j ? std::max(svm_float_t(0), L_i + L_j - C_i)
                        : std::max(svm_float_t(0), L_j - L_i);
-        svm_float_t L_j_high = y_i == y_j
-                                   ? std::min(Tolerance, L_i + L_j)
-                                   : std::min(Tolerance, Tolerance + L_j - L_i);
+        svm_float_t L_j_high = y_i == y_j ? std::min(C_j, L_i + L_j)
+                                          : std::min(C_j, C_i + L_j - L_i);
         svm_float_t L_j_new = std::clamp(
-            L_j + y_j * (sum.dot(x_i - x_j) - y_i + y_j) /
-                      (x_i.dot(x_i) + x_j.dot(x_j) - x_i.dot(x_j) * 2),
+            L_j + y_j * (sum.dot(x_i) - sum.dot(x_j) - y_i + y_j) /
+                      x_i.squared_distance(x_j),
             L_j_low, L_j_high);
 
         svm_float_t L_y_sum = L_i * y_i + L_j * y_j;
         svm_float_t L_i_new = (L_y_sum - L_j_new * y_j) * y_i;
         modify += std::abs(L_i_new - L_i) + std::abs(L_j_new - L_j);
 
+        // 差分更新
+        sum.axpy((L_i_new - L_i) * y_i, x_i).axpy((L_j_new - L_j) * y_j, x_j);
         L_i = L_i_new;
         L_j = L_j_new;
-        // 差分更新
-        sum = tsum + x_i * (L_i * y_i) + x_j * (L_j * y_j);
       }
     // 报告回调
     ModifyCallback(modify);
@@ -0,0 +1,494 @@
+#ifndef __SVM_OUT_OF_CORE_SMO_HPP__
+#define __SVM_OUT_OF_CORE_SMO_HPP__
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "DataSet/MappedDataSet.hpp"
+#include "Kernel/BuiltinKernel.hpp"
+#include "SVM/SVM.hpp"
+#include "common/Parallel.hpp"
+#include "common/common.hpp"
+
+namespace SVM {
+
+// 按行缓存核矩阵，未命中时分块流式读取磁盘样本并计算该行
+// 只计算活动集内的元素，需要整行时再补齐其余元素；
+// 处理每块前预读后续的块，处理后释放该块的映射页，缓存总量受MaxMemUsage约束
+// kernel会被Threads个线程同时调用
+template <std::size_t Dimension, std::floating_point svm_float_t = double>
+class KernelRowCache {
+  using data_t = FixedVector<Dimension, svm_float_t>;
+  using kernel_function_t =
+      std::function<svm_float_t(const data_t&, const data_t&)>;
+  static constexpr std::size_t None = SIZE_MAX;
+
+  struct Slot {
+    std::vector<svm_float_t> row;
+    std::size_t owner = None;
+    // 是否已计算活动集外的元素
+    bool complete = false;
+  };
+
+  const MappedDataSet<Dimension, svm_float_t>& data;
+  kernel_function_t kernel;
+  std::size_t BlockRows;
+  ThreadPool pool;
+
+  std::vector<Slot> slot;
+  // 第i行所在的槽位
+  std::vector<std::size_t> position;
+  // 以最后一个元素为哨兵的LRU双向链表，表头为最近使用
+  std::vector<std::size_t> prev, next;
+  std::vector<char> active;
+  std::size_t active_count;
+
+  void Unlink(std::size_t);
+  void PushFront(std::size_t);
+  // 分块流式遍历全部样本，func(first, last)处理一块
+  template <class Func>
+  void Stream(const Func&);
+  // 计算第i行中need(t)为真的元素
+  template <class Need>
+  void Compute(std::size_t i, svm_float_t* row, const Need&);
+
+ public:
+  KernelRowCache(const MappedDataSet<Dimension, svm_float_t>&,
+                 const kernel_function_t&, std::size_t CacheRows = 0,
+                 std::size_t BlockRows = 1 << 12,
+                 std::size_t Threads = DefaultThreads());
+
+  // 返回的行至少在下一次取其他行之前有效
+  // complete为假时只保证活动集内的元素正确
+  const svm_float_t* Row(std::size_t, bool complete = false);
+  std::vector<svm_float_t> Diagonal();
+
+  bool Active(std::size_t i) const { return active[i]; }
+  // 将i移出活动集，已缓存的行仍然有效
+  void Deactivate(std::size_t);
+  // 恢复全部样本为活动，并丢弃只含部分元素的行
+  void ActivateAll();
+};
+
+// 工作集SMO：每次按二阶信息选取违反KKT条件最严重的一对(i, j)更新，
+// 只需要第i、j两行核矩阵，并周期性地收缩不可能再变化的样本，
+// 与LIBSVM的求解过程相同；lambda从0开始，其余参数含义同WeightedSMOSolve
+// 每n次更新计为一轮，最大违反量小于ModifyLimit时停止，返回bias
+template <std::floating_point svm_float_t, class label_function_t,
+          class bound_function_t, std::size_t Dimension>
+svm_float_t WorkingSetSMOSolve(
+    const label_function_t& label, const bound_function_t& bound,
+    KernelRowCache<Dimension, svm_float_t>& cache,
+    std::span<svm_float_t> lambda, std::size_t EpochLimit,
+    svm_float_t ModifyLimit,
+    const DataCallback<std::size_t>& EpochCallback = [](std::size_t) {},
+    const DataCallback<decltype(svm_float_t())>& ModifyCallback =
+        [](svm_float_t) {});
+
+// 基于内存映射样本矩阵的SMO，常驻内存的只有lambda、梯度、分类与核行缓存
+// 以WorkingSetSMOSolve求解，ModifyCallback报告每轮lambda的变化总量；
+// CacheRows为0时按MaxMemUsage决定缓存行数；Threads只用于内置核，
+// 自定义核总在调用线程上串行计算，不要求其线程安全；其余参数含义同SMO
+template <std::size_t Dimension, std::floating_point svm_float_t = double>
+CompactSVM<Dimension, svm_float_t> OutOfCoreSMO(
+    const MappedDataSet<Dimension, svm_float_t>&,
+    const typename CompactSVM<Dimension, svm_float_t>::kernel_function_t&,
+    svm_float_t Tolerance, std::size_t EpochLimit, svm_float_t ModifyLimit,
+    std::size_t CacheRows = 0, std::size_t Threads = DefaultThreads(),
+    const DataCallback<std::size_t>& EpochCallback = [](std::size_t) {},
+    const DataCallback<decltype(svm_float_t())>& ModifyCallback =
+        [](svm_float_t) {});
+
+}  // namespace SVM
+
+//////////implementation//////////
+
+namespace SVM {
+
+template <std::size_t Dimension, std::floating_point svm_float_t>
+KernelRowCache<Dimension, svm_float_t>::KernelRowCache(
+    const MappedDataSet<Dimension, svm_float_t>& _data,
+    const kernel_function_t& _kernel, std::size_t CacheRows,
+    std::size_t _BlockRows, std::size_t Threads)
+    : data(_data),
+      kernel(_kernel),
+      BlockRows(std::max<std::size_t>(1, _BlockRows)),
+      pool(Threads),
+      position(_data.Size(), None),
+      active(_data.Size(), 1),
+      active_count(_data.Size()) {
+  const std::size_t n = data.Size();
+  if (CacheRows == 0)
+    CacheRows = MaxMemUsage / (sizeof(svm_float_t) * std::max<std::size_t>(
+                                                         1, n));
+  // 更新时同时需要第i、j两行
+  CacheRows = std::clamp<std::size_t>(CacheRows, 2, std::max<std::size_t>(
+                                                        2, n));
+  slot.resize(CacheRows);
+  prev.resize(CacheRows + 1);
+  next.resize(CacheRows + 1);
+  prev[CacheRows] = next[CacheRows] = CacheRows;
+  for (std::size_t s = 0; s < CacheRows; s++) PushFront(s);
+}
+
+template <std::size_t Dimension, std::floating_point svm_float_t>
+void KernelRowCache<Dimension, svm_float_t>::Unlink(std::size_t s) {
+  next[prev[s]] = next[s];
+  prev[next[s]] = prev[s];
+}
+
+template <std::size_t Dimension, std::floating_point svm_float_t>
+void KernelRowCache<Dimension, svm_float_t>::PushFront(std::size_t s) {
+  const std::size_t head = slot.size();
+  prev[s] = head;
+  next[s] = next[head];
+  prev[next[head]] = s;
+  next[head] = s;
+}
+
+template <std::size_t Dimension, std::floating_point svm_float_t>
+template <class Func>
+void KernelRowCache<Dimension, svm_float_t>::Stream(const Func& func) {
+  const std::size_t n = data.Size();
+  const std::size_t blocks = (n + BlockRows - 1) / BlockRows;
+  const std::size_t ahead = pool.Threads() * BlockRows;
+  data.WillNeed(0, ahead);
+  pool.ParallelFor(blocks, [&](std::size_t b) {
+    const std::size_t first = b * BlockRows;
+    const std::size_t last = std::min(n, first + BlockRows);
+    data.WillNeed(first + ahead, last + ahead);
+    func(first, last);
+    // 每行都会重新扫描全部样本，用过的块不必常驻内存
+    data.DontNeed(first, last);
+  });
+}
+
+template <std::size_t Dimension, std::floating_point svm_float_t>
+template <class Need>
+void KernelRowCache<Dimension, svm_float_t>::Compute(std::size_t i,
+                                                     svm_float_t* row,
+                                                     const Need& need) {
+  const data_t x_i = data.Data(i);
+  Stream([&](std::size_t first, std::size_t last) {
+    for (std::size_t t = first; t < last; t++)
+      if (need(t)) row[t] = kernel(x_i, data.Data(t));
+  });
+}
+
+template <std::size_t Dimension, std::floating_point svm_float_t>
+const svm_float_t* KernelRowCache<Dimension, svm_float_t>::Row(
+    std::size_t i, bool complete) {
+  std::size_t s = position[i];
+  if (s == None) {
+    // 淘汰最久未使用的行
+    s = prev[slot.size()];
+    Slot& victim = slot[s];
+    if (victim.owner != None) position[victim.owner] = None;
+    victim.owner = i;
+    position[i] = s;
+    victim.row.resize(data.Size());
+    victim.complete = complete || active_count == data.Size();
+    if (victim.complete)
+      Compute(i, victim.row.data(), [](std::size_t) { return true; });
+    else
+      Compute(i, victim.row.data(),
+              [&](std::size_t t) { return bool(active[t]); });
+  } else if (complete && !slot[s].complete) {
+    Compute(i, slot[s].row.data(),
+            [&](std::size_t t) { return !active[t]; });
+    slot[s].complete = true;
+  }
+  Unlink(s);
+  PushFront(s);
+  return slot[s].row.data();
+}
+
+template <std::size_t Dimension, std::floating_point svm_float_t>
+std::vector<svm_float_t> KernelRowCache<Dimension, svm_float_t>::Diagonal() {
+  std::vector<svm_float_t> diagonal(data.Size());
+  Stream([&](std::size_t first, std::size_t last) {
+    for (std::size_t t = first; t < last; t++) {
+      const data_t x = data.Data(t);
+      diagonal[t] = kernel(x, x);
+    }
+  });
+  return diagonal;
+}
+
+template <std::size_t Dimension, std::floating_point svm_float_t>
+void KernelRowCache<Dimension, svm_float_t>::Deactivate(std::size_t i) {
+  if (!active[i]) return;
+  active[i] = 0;
+  active_count--;
+}
+
+template <std::size_t Dimension, std::floating_point svm_float_t>
+void KernelRowCache<Dimension, svm_float_t>::ActivateAll() {
+  if (active_count == data.Size()) return;
+  std::ranges::fill(active, 1);
+  active_count = data.Size();
+  for (std::size_t s = 0; s < slot.size(); s++)
+    if (slot[s].owner != None && !slot[s].complete) {
+      position[slot[s].owner] = None;
+      slot[s].owner = None;
+      // 空出的槽位优先复用
+      Unlink(s);
+      next[s] = slot.size();
+      prev[s] = prev[slot.size()];
+      next[prev[s]] = s;
+      prev[slot.size()] = s;
+    }
+}
+
+template <std::floating_point svm_float_t, class label_function_t,
+          class bound_function_t, std::size_t Dimension>
+svm_float_t WorkingSetSMOSolve(
+    const label_function_t& label, const bound_function_t& bound,
+    KernelRowCache<Dimension, svm_float_t>& cache,
+    std::span<svm_float_t> lambda, std::size_t EpochLimit,
+    svm_float_t ModifyLimit,
+    const DataCallback<std::size_t>& EpochCallback,
+    const DataCallback<decltype(svm_float_t())>& ModifyCallback) {
+  constexpr svm_float_t Tau = 1e-12;
+  constexpr svm_float_t Inf = std::numeric_limits<svm_float_t>::infinity();
+  constexpr std::size_t None = SIZE_MAX;
+  const std::size_t n = lambda.size();
+
+  const std::vector<svm_float_t> QD = cache.Diagonal();
+  std::ranges::fill(lambda, 0);
+  // 对偶目标 1/2 * a^T Q a - sum(a) 的梯度，Q_ij = y_i * y_j * K_ij
+  std::vector<svm_float_t> G(n, -1);
+  // 处于上界的lambda对梯度的贡献，用于恢复被收缩样本的梯度
+  std::vector<svm_float_t> G_bar(n, 0);
+  // 活动集，按升序排列
+  std::vector<std::size_t> active(n);
+  std::iota(active.begin(), active.end(), 0);
+
+  auto upper = [&](std::size_t t) { return lambda[t] >= bound(t); };
+  auto lower = [&](std::size_t t) { return lambda[t] <= 0; };
+  // y_t * lambda_t可以增大/减小的样本
+  auto can_up = [&](std::size_t t) {
+    return label(t) == 1 ? !upper(t) : !lower(t);
+  };
+  auto can_down = [&](std::size_t t) {
+    return label(t) == 1 ? !lower(t) : !upper(t);
+  };
+
+  // 二阶工作集选择，返回最大违反量；已满足KKT条件时j为None
+  std::size_t i = None, j = None;
+  auto select = [&] {
+    svm_float_t Gmax = -Inf, Gmax2 = -Inf, best = Inf;
+    i = j = None;
+    for (std::size_t t : active)
+      if (can_up(t) && -label(t) * G[t] >= Gmax) {
+        Gmax = -label(t) * G[t];
+        i = t;
+      }
+    if (i == None) return svm_float_t(0);
+    const svm_float_t* K_i = cache.Row(i);
+    for (std::size_t t : active) {
+      if (!can_down(t)) continue;
+      const svm_float_t yG = label(t) * G[t];
+      Gmax2 = std::max(Gmax2, yG);
+      const svm_float_t diff = Gmax + yG;
+      if (diff <= 0) continue;
+      const svm_float_t quad = QD[i] + QD[t] - 2 * K_i[t];
+      const svm_float_t obj = -diff * diff / (quad > 0 ? quad : Tau);
+      if (obj <= best) {
+        best = obj;
+        j = t;
+      }
+    }
+    return Gmax + Gmax2;
+  };
+
+  auto free_count = [&] {
+    return std::ranges::count_if(
+        active, [&](std::size_t t) { return !upper(t) && !lower(t); });
+  };
+  // 恢复被收缩样本的梯度，之后全部样本重新成为活动集
+  auto reconstruct = [&] {
+    if (active.size() == n) return;
+    for (std::size_t t = 0; t < n; t++)
+      if (!cache.Active(t)) G[t] = G_bar[t] - 1;
+    if (std::size_t(free_count()) * n > 2 * active.size() * (n - active.size()))
+      for (std::size_t t = 0; t < n; t++) {
+        if (cache.Active(t)) continue;
+        const svm_float_t* K_t = cache.Row(t);
+        for (std::size_t s : active)
+          if (!upper(s) && !lower(s))
+            G[t] += lambda[s] * label(s) * label(t) * K_t[s];
+      }
+    else
+      for (std::size_t s : active) {
+        if (upper(s) || lower(s)) continue;
+        const svm_float_t* K_s = cache.Row(s, true);
+        for (std::size_t t = 0; t < n; t++)
+          if (!cache.Active(t))
+            G[t] += lambda[s] * label(s) * label(t) * K_s[t];
+      }
+    active.resize(n);
+    std::iota(active.begin(), active.end(), 0);
+    cache.ActivateAll();
+  };
+
+  bool unshrunk = false;
+  auto shrink = [&] {
+    svm_float_t Gmax1 = -Inf, Gmax2 = -Inf;
+    for (std::size_t t : active) {
+      const svm_float_t yG = label(t) * G[t];
+      if (can_up(t)) Gmax1 = std::max(Gmax1, -yG);
+      if (can_down(t)) Gmax2 = std::max(Gmax2, yG);
+    }
+    // 接近收敛时恢复一次完整的梯度，避免过早收缩
+    if (!unshrunk && Gmax1 + Gmax2 <= ModifyLimit * 10) {
+      unshrunk = true;
+      reconstruct();
+    }
+    // 处于边界且梯度表明其不会离开边界的样本移出活动集
+    std::erase_if(active, [&](std::size_t t) {
+      const svm_float_t yG = label(t) * G[t];
+      const bool shrunk =
+          (!can_up(t) && -yG > Gmax1) || (!can_down(t) && yG > Gmax2);
+      if (shrunk) cache.Deactivate(t);
+      return shrunk;
+    });
+  };
+
+  std::size_t counter = std::min<std::size_t>(n, 1000) + 1, epoch = 0;
+  svm_float_t modify = 0;
+  for (std::size_t iteration = 1; epoch != EpochLimit; iteration++) {
+    if (--counter == 0) {
+      counter = std::min<std::size_t>(n, 1000);
+      shrink();
+    }
+    if (select() < ModifyLimit || j == None) {
+      // 在全部样本上确认已满足停止条件
+      reconstruct();
+      if (select() < ModifyLimit || j == None) break;
+      counter = 1;
+    }
+
+    const svm_float_t* K_i = cache.Row(i);
+    const svm_float_t* K_j = cache.Row(j);
+    const svm_float_t y_i = label(i), y_j = label(j);
+    const svm_float_t C_i = bound(i), C_j = bound(j);
+    const svm_float_t old_i = lambda[i], old_j = lambda[j];
+    const bool upper_i = upper(i), upper_j = upper(j);
+    svm_float_t& L_i = lambda[i];
+    svm_float_t& L_j = lambda[j];
+
+    svm_float_t quad = QD[i] + QD[j] - 2 * K_i[j];
+    if (quad <= 0) quad = Tau;
+    if (y_i != y_j) {
+      const svm_float_t delta = (-G[i] - G[j]) / quad, diff = L_i - L_j;
+      L_i += delta;
+      L_j += delta;
+      if (diff > 0) {
+        if (L_j < 0) L_j = 0, L_i = diff;
+      } else if (L_i < 0)
+        L_i = 0, L_j = -diff;
+      if (diff > C_i - C_j) {
+        if (L_i > C_i) L_i = C_i, L_j = C_i - diff;
+      } else if (L_j > C_j)
+        L_j = C_j, L_i = C_j + diff;
+    } else {
+      const svm_float_t delta = (G[i] - G[j]) / quad, sum = L_i + L_j;
+      L_i -= delta;
+      L_j += delta;
+      if (sum > C_i) {
+        if (L_i > C_i) L_i = C_i, L_j = sum - C_i;
+      } else if (L_j < 0)
+        L_j = 0, L_i = sum;
+      if (sum > C_j) {
+        if (L_j > C_j) L_j = C_j, L_i = sum - C_j;
+      } else if (L_i < 0)
+        L_i = 0, L_j = sum;
+    }
+
+    const svm_float_t d_i = (L_i - old_i) * y_i, d_j = (L_j - old_j) * y_j;
+    for (std::size_t t : active)
+      G[t] += label(t) * (d_i * K_i[t] + d_j * K_j[t]);
+    // lambda进出上界时更新G_bar，需要整行
+    for (auto [t, was_upper] : {std::pair(i, upper_i), std::pair(j, upper_j)})
+      if (was_upper != upper(t)) {
+        const svm_float_t* K_t = cache.Row(t, true);
+        const svm_float_t c = (was_upper ? -1 : 1) * bound(t) * label(t);
+        for (std::size_t s = 0; s < n; s++) G_bar[s] += c * label(s) * K_t[s];
+      }
+
+    modify += std::abs(L_i - old_i) + std::abs(L_j - old_j);
+    if (iteration % n == 0) {
+      ModifyCallback(modify);
+      EpochCallback(epoch++);
+      modify = 0;
+    }
+  }
+  reconstruct();
+
+  // 由自由的lambda求bias，没有时取可行区间的中点
+  svm_float_t upper_bound = Inf, lower_bound = -Inf, sum = 0;
+  std::size_t free = 0;
+  for (std::size_t t = 0; t < n; t++) {
+    const svm_float_t yG = label(t) * G[t];
+    if (upper(t) ? label(t) == -1 : lower(t) && label(t) == 1)
+      upper_bound = std::min(upper_bound, yG);
+    else if (upper(t) || lower(t))
+      lower_bound = std::max(lower_bound, yG);
+    else {
+      free++;
+      sum += yG;
+    }
+  }
+  return free > 0 ? -sum / free : -(upper_bound + lower_bound) / 2;
+}
+
+template <std::size_t Dimension, std::floating_point svm_float_t>
+CompactSVM<Dimension, svm_float_t> OutOfCoreSMO(
+    const MappedDataSet<Dimension, svm_float_t>& data,
+    const typename CompactSVM<Dimension, svm_float_t>::kernel_function_t&
+        kernel,
+    svm_float_t Tolerance, std::size_t EpochLimit, svm_float_t ModifyLimit,
+    std::size_t CacheRows, std::size_t Threads,
+    const DataCallback<std::size_t>& EpochCallback,
+    const DataCallback<decltype(svm_float_t())>& ModifyCallback) {
+  const std::size_t n = data.Size();
+  if (n == 0) throw std::runtime_error("Fail to train on no sample.");
+  // 分类每样本仅1字节，常驻内存以避免随机访问磁盘
+  std::vector<int8_t> classification(n);
+  for (std::size_t i = 0; i < n; i++) {
+    classification[i] = data.Label(i);
+    if (classification[i] == 0)
+      throw std::runtime_error("Invalid label in data file.");
+  }
+  auto label = [&](std::size_t i) {
+    return ClassificationType(classification[i]);
+  };
+  auto bound = [&](std::size_t) { return Tolerance; };
+
+  std::vector<svm_float_t> lambda(n);
+  KernelRowCache<Dimension, svm_float_t> cache(
+      data, kernel, CacheRows, 1 << 12,
+      KernelThreads<Dimension, svm_float_t>(kernel, Threads));
+  CompactSVM<Dimension, svm_float_t> result(kernel);
+  result.bias = WorkingSetSMOSolve(label, bound, cache,
+                                   std::span<svm_float_t>(lambda), EpochLimit,
+                                   ModifyLimit, EpochCallback, ModifyCallback);
+  for (std::size_t i = 0; i < n; i++)
+    if (sgn(lambda[i]) != 0) {
+      result.support.push_back(data[i]);
+      result.lambda.push_back(lambda[i]);
+    }
+  return result;
+}
+
+}  // namespace SVM
+
+#endif
\ No newline at end of file
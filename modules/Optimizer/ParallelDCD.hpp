@@ -0,0 +1,121 @@
+#ifndef __SVM_PARALLEL_DCD_HPP__
+#define __SVM_PARALLEL_DCD_HPP__
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "SVM/SVM.hpp"
+#include "Sample/Sample.hpp"
+#include "SegmentPlane/SegmentPlane.hpp"
+#include "common/Parallel.hpp"
+#include "common/common.hpp"
+namespace SVM {
+
+// ParallelDCD的迭代核心，样本数在运行时决定
+// sample[i]为第i个样本，bound(i)为lambda_i的上界，lambda的大小即样本数，
+// 返回由lambda合并得到的分界面
+template <std::size_t Dimension, std::floating_point svm_float_t,
+          std::random_access_iterator randomIt, class bound_function_t>
+SegmentPlane<Dimension, svm_float_t> ParallelDCDSolve(
+    randomIt sample, const bound_function_t& bound,
+    std::span<svm_float_t> lambda, std::size_t EpochLimit,
+    svm_float_t ModifyLimit, std::size_t seed, std::size_t Threads,
+    const DataCallback<std::size_t>& EpochCallback = [](std::size_t) {},
+    const DataCallback<decltype(svm_float_t())>& ModifyCallback =
+        [](svm_float_t) {}) {
+  const std::size_t n = lambda.size();
+  if (Threads == 0) Threads = DefaultThreads();
+  Threads = std::max<std::size_t>(1, std::min(Threads, n));
+
+  SegmentPlane<Dimension, svm_float_t> plane{{}, 0};
+  std::vector<svm_float_t> Q(n);
+  for (std::size_t i = 0; i < n; i++) {
+    lambda[i] = 0;
+    Q[i] = sample[i].data.dot(sample[i].data) + 1;
+  }
+
+  std::vector<std::size_t> order(n);
+  std::iota(order.begin(), order.end(), 0);
+  std::mt19937 Engine(seed);
+
+  for (std::size_t epoch = 0; epoch != EpochLimit; epoch++) {
+    std::ranges::shuffle(order, Engine);
+    std::atomic<svm_float_t> modify = 0;
+    ParallelFor(
+        Threads,
+        [&](std::size_t t) {
+          svm_float_t local_modify = 0;
+          for (std::size_t k = t; k < n; k += Threads) {
+            const std::size_t i = order[k];
+            const auto& [y_i, x_i] = sample[i];
+            // 其它线程可能同时写入，只需读到某一时刻的近似值
+            svm_float_t v = std::atomic_ref(plane.bias).load(
+                std::memory_order_relaxed);
+            for (std::size_t d = 0; d < Dimension; d++)
+              v += std::atomic_ref(plane.weight[d]).load(
+                       std::memory_order_relaxed) *
+                   x_i[d];
+            const svm_float_t G = y_i * v - 1;
+            svm_float_t& L_i = lambda[i];
+            const svm_float_t L_i_new =
+                std::clamp(L_i - G / Q[i], svm_float_t(0), bound(i));
+            if (L_i_new == L_i) continue;
+
+            const svm_float_t delta = (L_i_new - L_i) * y_i;
+            for (std::size_t d = 0; d < Dimension; d++)
+              std::atomic_ref(plane.weight[d])
+                  .fetch_add(delta * x_i[d], std::memory_order_relaxed);
+            std::atomic_ref(plane.bias).fetch_add(delta,
+                                                  std::memory_order_relaxed);
+            local_modify += std::abs(L_i_new - L_i);
+            L_i = L_i_new;
+          }
+          modify.fetch_add(local_modify, std::memory_order_relaxed);
+        },
+        Threads);
+    // 报告回调
+    ModifyCallback(modify);
+    EpochCallback(epoch);
+    if (modify < ModifyLimit) break;
+  }
+
+  // 以最终的lambda重新合并，消除并发累加的舍入误差
+  plane = {{}, 0};
+  for (std::size_t i = 0; i < n; i++) {
+    plane.weight.axpy(lambda[i] * sample[i].classification, sample[i].data);
+    plane.bias += lambda[i] * sample[i].classification;
+  }
+  return plane;
+}
+
+// 异步并行对偶坐标下降(PASSCoDe)，用于线性核
+// 样本在每轮被随机划分给Threads个线程，各线程更新互不相交的lambda，
+// 并以无锁原子加法把变化量直接累加到共享的SegmentPlane上
+// bias视为值恒为1的额外维度一同优化；Threads为0时使用全部核心
+template <std::size_t DataSetSize, std::size_t Dimension,
+          std::floating_point svm_float_t>
+void ParallelDCD(SVM<DataSetSize, Dimension, svm_float_t>& svm,
+                 svm_float_t Tolerance, std::size_t EpochLimit,
+                 svm_float_t ModifyLimit, std::size_t seed,
+                 std::size_t Threads,
+                 const DataCallback<std::size_t>& EpochCallback,
+                 const DataCallback<decltype(svm_float_t())>& ModifyCallback) {
+  svm.bias =
+      ParallelDCDSolve<Dimension>(
+          svm.sample.begin(),
+          [&](std::size_t i) { return Tolerance * svm.weight[i]; },
+          std::span<svm_float_t>(&svm.lambda[0], DataSetSize), EpochLimit,
+          ModifyLimit, seed, Threads, EpochCallback, ModifyCallback)
+          .bias;
+}
+
+}  // namespace SVM
+
+#endif
\ No newline at end of file
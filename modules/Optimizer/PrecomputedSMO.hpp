@@ -0,0 +1,57 @@
+#ifndef __SVM_PRECOMPUTED_SMO_HPP__
+#define __SVM_PRECOMPUTED_SMO_HPP__
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "DataSet/MappedGramMatrix.hpp"
+#include "Optimizer/SMO.hpp"
+#include "SVM/PrecomputedSVM.hpp"
+#include "common/common.hpp"
+
+namespace SVM {
+
+// 以离线计算的核矩阵训练，求解过程中不计算核函数
+// gram为训练集方阵(Full或Upper)，label[i]为第i个样本的分类，其余参数含义同SMO
+template <std::floating_point svm_float_t = double,
+          std::floating_point gram_float_t = svm_float_t>
+PrecomputedSVM<svm_float_t> PrecomputedSMO(
+    std::span<const ClassificationType> label,
+    const MappedGramMatrix<gram_float_t>& gram, svm_float_t Tolerance,
+    std::size_t EpochLimit, svm_float_t ModifyLimit, std::size_t seed = 0,
+    const DataCallback<std::size_t>& EpochCallback = [](std::size_t) {},
+    const DataCallback<decltype(svm_float_t())>& ModifyCallback =
+        [](svm_float_t) {}) {
+  const std::size_t n = label.size();
+  if (gram.Rows() != n || gram.Cols() != n)
+    throw std::runtime_error("Fail to train: gram matrix is " +
+                             std::to_string(gram.Rows()) + "x" +
+                             std::to_string(gram.Cols()) + " for " +
+                             std::to_string(n) + " samples.");
+  // SMO逐行扫描核矩阵，提前预读
+  gram.WillNeed();
+
+  auto label_of = [&](std::size_t i) { return label[i]; };
+  std::vector<svm_float_t> lambda(n);
+  SMOInitLambda(label_of, std::span<svm_float_t>(lambda), seed);
+
+  PrecomputedSVM<svm_float_t> svm;
+  svm.train_size = n;
+  svm.bias = SMOSolve(
+      label_of,
+      [&](std::size_t i, std::size_t j) { return svm_float_t(gram(i, j)); },
+      std::span<svm_float_t>(lambda), Tolerance, EpochLimit, ModifyLimit,
+      EpochCallback, ModifyCallback);
+  for (std::size_t i = 0; i < n; i++) {
+    if (sgn(lambda[i]) == 0) continue;
+    svm.support.push_back(i);
+    svm.coefficient.push_back(lambda[i] * label[i]);
+  }
+  return svm;
+}
+
+}  // namespace SVM
+
+#endif
\ No newline at end of file
@@ -1,85 +1,62 @@
 #ifndef __SVM_SMO_HPP__
 #define __SVM_SMO_HPP__
 #include <algorithm>
-#include <array>
 #include <cmath>
 #include <cstddef>
 #include <cstdlib>
 #include <functional>
+#include <limits>
 #include <random>
+#include <ranges>
+#include <span>
 #include <utility>
+#include <vector>
 
+#include "Kernel/BuiltinKernel.hpp"
+#include "KernelMatrix/KernelMatrix.hpp"
 #include "SVM/SVM.hpp"
+#include "common/Parallel.hpp"
 #include "common/common.hpp"
 
 namespace SVM {
 
-template <std::size_t DataSetSize, std::size_t Dimension,
-          std::floating_point svm_float_t>
-void SMO(SVM<DataSetSize, Dimension, svm_float_t>& svm, svm_float_t Tolerance,
-         std::size_t EpochLimit, svm_float_t ModifyLimit, std::size_t seed,
-         const DataCallback<std::size_t>& EpochCallback,
-         const DataCallback<decltype(svm_float_t())>& ModifyCallback) {
-  using vector_t = FixedVector<Dimension, svm_float_t>;
-
-  std::mt19937 Engine(seed);
-  std::uniform_real_distribution<svm_float_t> RealDistribution(-1, 1);
-
-  std::ranges::generate(svm.lambda, [&] { return RealDistribution(Engine); });
-  svm.lambda[0] += -std::transform_reduce(
-      svm.sample.begin(), svm.sample.end(), svm.lambda.begin(), svm_float_t(0),
-      std::plus<>{},
-      [](const Sample<Dimension, svm_float_t>& v, const svm_float_t& L) {
-        return L * v.classification;
-      });
-
-  std::function<svm_float_t(int, int)> kernel;
-  std::array<svm_float_t, DataSetSize * (1 + DataSetSize) / 2>* kernel_save =
-      nullptr;
-  // 空间占用不大时预处理出运算结果
-  if constexpr (DataSetSize * (1 + DataSetSize) / 2 * sizeof(svm_float_t) <=
-                MaxMemUsage) {
-    kernel_save =
-        new std::array<svm_float_t, DataSetSize * (1 + DataSetSize) / 2>;
-    for (int i = 0; i < DataSetSize; i++)
-      for (int j = 0; j <= i; j++)
-        (*kernel_save)[(i + 1) * i / 2 + j] =
-            svm.kernel(svm.sample[i].data, svm.sample[j].data);
-    kernel = [&](int i, int j) {
-      if (i < j) std::swap(i, j);
-      return (*kernel_save)[(i + 1) * i / 2 + j];
-    };
-  } else
-    // 不储存运算结果
-    kernel = [&](int i, int j) {
-      return svm.kernel(svm.sample[i].data, svm.sample[j].data);
-    };
-
-  FixedVector<DataSetSize, svm_float_t> E;
-  for (int i = 0; i < DataSetSize; i++) {
-    E[i] = svm.bias - svm.sample[i].classification;
-    for (int j = 0; j < DataSetSize; j++)
-      E[i] += svm.lambda[j] * svm.sample[j].classification * kernel(i, j);
+// 不依赖定长数据集的SMO迭代核心，供SMO及各类子问题训练复用
+// label(i)与kernel(i, j)给出样本分类与核函数值，bound(i)为lambda_i的上界，
+// lambda需预先初始化，返回bias
+template <std::floating_point svm_float_t, class label_function_t,
+          class bound_function_t, class kernel_index_t>
+svm_float_t WeightedSMOSolve(
+    const label_function_t& label, const bound_function_t& bound,
+    const kernel_index_t& kernel, std::span<svm_float_t> lambda,
+    std::size_t EpochLimit, svm_float_t ModifyLimit,
+    const DataCallback<std::size_t>& EpochCallback = [](std::size_t) {},
+    const DataCallback<decltype(svm_float_t())>& ModifyCallback =
+        [](svm_float_t) {}) {
+  const std::size_t n = lambda.size();
+
+  std::vector<svm_float_t> E(n);
+  for (std::size_t i = 0; i < n; i++) {
+    E[i] = -label(i);
+    for (std::size_t j = 0; j < n; j++)
+      E[i] += lambda[j] * label(j) * kernel(i, j);
   }
 
   for (std::size_t epoch = 0; epoch != EpochLimit; epoch++) {
     svm_float_t modify = 0;
-    for (int i = 0; i < DataSetSize; i++)
-      for (int j = 0; j < DataSetSize; j++) {
-        if (svm.sample[i].classification == svm.sample[j].classification)
-          continue;
+    for (std::size_t i = 0; i < n; i++)
+      for (std::size_t j = 0; j < n; j++) {
+        const ClassificationType y_i = label(i), y_j = label(j);
+        if (y_i == y_j) continue;
 
-        svm_float_t& L_i = svm.lambda[i];
-        svm_float_t& L_j = svm.lambda[j];
-        const auto& [y_i, x_i] = svm.sample[i];
-        const auto& [y_j, x_j] = svm.sample[j];
+        svm_float_t& L_i = lambda[i];
+        svm_float_t& L_j = lambda[j];
 
+        const svm_float_t C_i = bound(i), C_j = bound(j);
         svm_float_t L_j_low =
-            y_i == y_j ? std::max(svm_float_t(0), L_i + L_j - Tolerance)
+            y_i == y_j ? std::max(svm_float_t(0), L_i + L_j - C_i)
                        : std::max(svm_float_t(0), L_j - L_i);
-        svm_float_t L_j_high = y_i == y_j
-                                   ? std::min(Tolerance, L_i + L_j)
-                                   : std::min(Tolerance, Tolerance + L_j - L_i);
+        svm_float_t L_j_high = y_i == y_j ? std::min(C_j, L_i + L_j)
+                                          : std::min(C_j, C_i + L_j - L_i);
         svm_float_t L_j_new = std::clamp(
             L_j + y_j * (E[i] - E[j]) /
                       (kernel(i, i) + kernel(j, j) - 2 * kernel(i, j)),
@@ -88,9 +65,9 @@ void SMO(SVM<DataSetSize, Dimension, svm_float_t>& svm, svm_float_t Tolerance,
         svm_float_t L_y_sum = L_i * y_i + L_j * y_j;
         svm_float_t L_i_new = (L_y_sum - L_j_new * y_j) * y_i;
 
-        for (int t = 0; t < DataSetSize; t++) {
-          E[t] += svm.sample[i].classification * (L_i_new - L_i) * kernel(i, t);
-          E[t] += svm.sample[j].classification * (L_j_new - L_j) * kernel(j, t);
+        for (std::size_t t = 0; t < n; t++) {
+          E[t] += y_i * (L_i_new - L_i) * kernel(i, t);
+          E[t] += y_j * (L_j_new - L_j) * kernel(j, t);
         }
 
         modify += std::abs(L_i_new - L_i) + std::abs(L_j_new - L_j);
@@ -106,10 +83,10 @@ void SMO(SVM<DataSetSize, Dimension, svm_float_t>& svm, svm_float_t Tolerance,
               max_bias_positive = -std::numeric_limits<svm_float_t>::max();
   svm_float_t min_bias_negative = std::numeric_limits<svm_float_t>::max(),
               max_bias_negative = -std::numeric_limits<svm_float_t>::max();
-  for (int t = 0; t < DataSetSize; t++) {
-    if (sgn(svm.lambda[t]) == 0) continue;
-    svm_float_t v = svm.sample[t].classification + E[t];
-    if (svm.sample[t].classification == 1) {
+  for (std::size_t t = 0; t < n; t++) {
+    if (sgn(lambda[t]) == 0) continue;
+    svm_float_t v = label(t) + E[t];
+    if (label(t) == 1) {
       if (v > max_bias_positive) max_bias_positive = v;
       if (v < min_bias_positive) min_bias_positive = v;
     } else {
@@ -119,11 +96,85 @@ void SMO(SVM<DataSetSize, Dimension, svm_float_t>& svm, svm_float_t Tolerance,
   }
   if (std::abs(max_bias_positive - min_bias_negative) >
       std::abs(min_bias_positive - max_bias_negative))
-    svm.bias = -(min_bias_positive + max_bias_negative) / 2;
+    return -(min_bias_positive + max_bias_negative) / 2;
   else
-    svm.bias = -(min_bias_negative + max_bias_positive) / 2;
+    return -(min_bias_negative + max_bias_positive) / 2;
+}
+
+// 所有lambda的上界均为Tolerance
+template <std::floating_point svm_float_t, class label_function_t,
+          class kernel_index_t>
+svm_float_t SMOSolve(
+    const label_function_t& label, const kernel_index_t& kernel,
+    std::span<svm_float_t> lambda, svm_float_t Tolerance,
+    std::size_t EpochLimit, svm_float_t ModifyLimit,
+    const DataCallback<std::size_t>& EpochCallback = [](std::size_t) {},
+    const DataCallback<decltype(svm_float_t())>& ModifyCallback =
+        [](svm_float_t) {}) {
+  return WeightedSMOSolve(
+      label, [&](std::size_t) { return Tolerance; }, kernel, lambda,
+      EpochLimit, ModifyLimit, EpochCallback, ModifyCallback);
+}
 
-  delete kernel_save;
+// 随机初始化lambda并保证sum(lambda_i * y_i) = 0
+// 修正量乘以y_0，使y_0 = -1时等式同样成立
+template <std::floating_point svm_float_t, class label_function_t>
+void SMOInitLambda(const label_function_t& label,
+                   std::span<svm_float_t> lambda, std::size_t seed) {
+  if (lambda.empty()) return;
+  std::mt19937 Engine(seed);
+  std::uniform_real_distribution<svm_float_t> RealDistribution(-1, 1);
+
+  std::ranges::generate(lambda, [&] { return RealDistribution(Engine); });
+  svm_float_t sum = 0;
+  for (std::size_t i = 0; i < lambda.size(); i++) sum += lambda[i] * label(i);
+  lambda[0] += -sum * label(0);
+}
+
+// kernel包装的是内置核时，以Row整行批量填充matrix并返回true
+// first[i]为第i个样本的数据，以Threads个线程填充
+template <std::size_t Dimension, std::floating_point svm_float_t,
+          class kernel_function_t, std::random_access_iterator randomIt>
+bool FillBuiltinKernel(KernelMatrix<svm_float_t>& matrix,
+                       const kernel_function_t& kernel, randomIt first,
+                       std::size_t Threads = DefaultThreads()) {
+  return VisitBuiltinKernel<Dimension, svm_float_t>(
+      kernel, [&](const auto& builtin) {
+        matrix.FillRows(first, builtin, Threads);
+      });
+}
+
+template <std::size_t DataSetSize, std::size_t Dimension,
+          std::floating_point svm_float_t>
+void SMO(SVM<DataSetSize, Dimension, svm_float_t>& svm, svm_float_t Tolerance,
+         std::size_t EpochLimit, svm_float_t ModifyLimit, std::size_t seed,
+         const DataCallback<std::size_t>& EpochCallback,
+         const DataCallback<decltype(svm_float_t())>& ModifyCallback) {
+  auto label = [&](std::size_t i) { return svm.sample[i].classification; };
+  auto bound = [&](std::size_t i) { return Tolerance * svm.weight[i]; };
+  std::span<svm_float_t> lambda(&svm.lambda[0], DataSetSize);
+  SMOInitLambda(label, lambda, seed);
+
+  auto kernel = [&](std::size_t i, std::size_t j) {
+    return svm.kernel(svm.sample[i].data, svm.sample[j].data);
+  };
+  // 空间占用不大时预处理出运算结果
+  if constexpr (KernelMatrix<svm_float_t>::Bytes(DataSetSize) <=
+                MaxMemUsage) {
+    KernelMatrix<svm_float_t> kernel_save(DataSetSize);
+    auto data = svm.sample | std::views::transform(
+                                 [](const auto& s) -> const auto& {
+                                   return s.data;
+                                 });
+    // 只有内置核并行填充，自定义核串行调用，不要求其线程安全
+    if (!FillBuiltinKernel<Dimension>(kernel_save, svm.kernel, data.begin()))
+      kernel_save.Fill(kernel, 1);
+    svm.bias = WeightedSMOSolve(label, bound, kernel_save, lambda, EpochLimit,
+                                ModifyLimit, EpochCallback, ModifyCallback);
+  } else
+    // 不储存运算结果
+    svm.bias = WeightedSMOSolve(label, bound, kernel, lambda, EpochLimit,
+                                ModifyLimit, EpochCallback, ModifyCallback);
 }
 
 }  // namespace SVM
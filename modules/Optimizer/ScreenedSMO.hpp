@@ -0,0 +1,199 @@
+#ifndef __SVM_SCREENED_SMO_HPP__
+#define __SVM_SCREENED_SMO_HPP__
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <random>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "Kernel/BuiltinKernel.hpp"
+#include "KernelMatrix/KernelMatrix.hpp"
+#include "Optimizer/SMO.hpp"
+#include "SVM/SVM.hpp"
+#include "Sample/Sample.hpp"
+#include "common/Parallel.hpp"
+#include "common/common.hpp"
+
+namespace SVM {
+
+// 回补阶段判定违反KKT条件的间隔容差
+const double ScreenKKTEps = 1e-3;
+
+// 两阶段训练：先以廉价的screen(x)为全部样本打分，y * screen(x) >= Margin的样本
+// 视为远离分界面并丢弃，只在其余候选样本上运行核SMO；
+// 之后检查被丢弃样本是否满足 y * f(x) >= 1，将违反者加回候选集并以当前lambda
+// 热启动重新求解，至多回补FeedbackLimit轮
+// screen可为LinearSVM等任意决策函数，会在Threads个线程上并行调用；
+// kernel为自定义核时总在调用线程上串行计算，不要求其线程安全
+// 其余参数含义同SMO，RoundCallback报告每轮求解时的候选集大小
+template <std::size_t Dimension, std::floating_point svm_float_t = double,
+          std::forward_iterator forwardIt,
+          std::invocable<const FixedVector<Dimension, svm_float_t>&>
+              screen_function_t>
+CompactSVM<Dimension, svm_float_t> ScreenedSMO(
+    forwardIt first, forwardIt last,
+    const typename CompactSVM<Dimension, svm_float_t>::kernel_function_t&
+        kernel,
+    const screen_function_t& screen, svm_float_t Margin, svm_float_t Tolerance,
+    std::size_t EpochLimit, svm_float_t ModifyLimit,
+    std::size_t FeedbackLimit = 8, std::size_t seed = 0,
+    std::size_t Threads = DefaultThreads(),
+    const DataCallback<std::size_t>& RoundCallback = [](std::size_t) {});
+
+// 以随机抽取的ScreenSize个样本训练的核模型作为screen
+template <std::size_t Dimension, std::floating_point svm_float_t = double,
+          std::forward_iterator forwardIt>
+CompactSVM<Dimension, svm_float_t> ScreenedSMO(
+    forwardIt first, forwardIt last,
+    const typename CompactSVM<Dimension, svm_float_t>::kernel_function_t&
+        kernel,
+    std::size_t ScreenSize, svm_float_t Margin, svm_float_t Tolerance,
+    std::size_t EpochLimit, svm_float_t ModifyLimit,
+    std::size_t FeedbackLimit = 8, std::size_t seed = 0,
+    std::size_t Threads = DefaultThreads(),
+    const DataCallback<std::size_t>& RoundCallback = [](std::size_t) {});
+
+}  // namespace SVM
+
+//////////implementation//////////
+
+namespace SVM {
+
+template <std::size_t Dimension, std::floating_point svm_float_t,
+          std::forward_iterator forwardIt,
+          std::invocable<const FixedVector<Dimension, svm_float_t>&>
+              screen_function_t>
+CompactSVM<Dimension, svm_float_t> ScreenedSMO(
+    forwardIt first, forwardIt last,
+    const typename CompactSVM<Dimension, svm_float_t>::kernel_function_t&
+        kernel,
+    const screen_function_t& screen, svm_float_t Margin, svm_float_t Tolerance,
+    std::size_t EpochLimit, svm_float_t ModifyLimit,
+    std::size_t FeedbackLimit, std::size_t seed, std::size_t Threads,
+    const DataCallback<std::size_t>& RoundCallback) {
+  using sample_t = Sample<Dimension, svm_float_t>;
+  const std::vector<sample_t> sample(first, last);
+  const std::size_t N = sample.size();
+  if (N == 0) throw std::runtime_error("Fail to train on no sample.");
+
+  // 第一阶段：为全部样本打分，只保留间隔附近及分错的样本
+  std::vector<char> candidate(N);
+  ParallelFor(
+      N,
+      [&](std::size_t i) {
+        const auto& [y, x] = sample[i];
+        candidate[i] = y * screen(x) < Margin;
+      },
+      Threads);
+  std::vector<std::size_t> index;
+  for (std::size_t i = 0; i < N; i++)
+    if (candidate[i]) index.push_back(i);
+  // SMO至少需要两类样本各一个
+  for (ClassificationType y : {1, -1})
+    if (std::ranges::none_of(index, [&](std::size_t i) {
+          return sample[i].classification == y;
+        }))
+      for (std::size_t i = 0; i < N; i++)
+        if (sample[i].classification == y) {
+          index.push_back(i);
+          candidate[i] = 1;
+          break;
+        }
+
+  std::vector<svm_float_t> lambda(index.size());
+  auto label = [&](std::size_t i) { return sample[index[i]].classification; };
+  SMOInitLambda(label, std::span<svm_float_t>(lambda), seed);
+
+  CompactSVM<Dimension, svm_float_t> result(kernel);
+  for (std::size_t feedback = 0;; feedback++) {
+    // 第二阶段：在候选集上运行核SMO
+    const std::size_t n = index.size();
+    RoundCallback(n);
+    auto raw_kernel = [&](std::size_t i, std::size_t j) {
+      return kernel(sample[index[i]].data, sample[index[j]].data);
+    };
+    std::span<svm_float_t> span(lambda);
+    if (KernelMatrix<svm_float_t>::Bytes(n) <= MaxMemUsage) {
+      KernelMatrix<svm_float_t> kernel_save(n);
+      auto data = index | std::views::transform(
+                              [&](std::size_t i) -> const auto& {
+                                return sample[i].data;
+                              });
+      if (!FillBuiltinKernel<Dimension>(kernel_save, kernel, data.begin(),
+                                        Threads))
+        kernel_save.Fill(raw_kernel, 1);
+      result.bias = SMOSolve(label, kernel_save, span, Tolerance, EpochLimit,
+                             ModifyLimit);
+    } else
+      result.bias = SMOSolve(label, raw_kernel, span, Tolerance, EpochLimit,
+                             ModifyLimit);
+
+    result.support.clear();
+    result.lambda.clear();
+    for (std::size_t i = 0; i < n; i++)
+      if (sgn(lambda[i]) != 0) {
+        result.support.push_back(sample[index[i]]);
+        result.lambda.push_back(lambda[i]);
+      }
+    if (feedback == FeedbackLimit) break;
+
+    // 检查被丢弃的样本是否满足 y * f(x) >= 1
+    std::vector<char> violate(N, 0);
+    ParallelFor(
+        N,
+        [&](std::size_t i) {
+          if (candidate[i]) return;
+          const auto& [y, x] = sample[i];
+          violate[i] = y * result.Decision(x) < 1 - ScreenKKTEps;
+        },
+        KernelThreads<Dimension, svm_float_t>(kernel, Threads));
+    if (std::ranges::find(violate, 1) == violate.end()) break;
+
+    // 违反者以lambda = 0加入，sum(lambda_i * y_i) = 0仍然成立
+    for (std::size_t i = 0; i < N; i++)
+      if (violate[i]) {
+        candidate[i] = 1;
+        index.push_back(i);
+        lambda.push_back(0);
+      }
+  }
+  return result;
+}
+
+template <std::size_t Dimension, std::floating_point svm_float_t,
+          std::forward_iterator forwardIt>
+CompactSVM<Dimension, svm_float_t> ScreenedSMO(
+    forwardIt first, forwardIt last,
+    const typename CompactSVM<Dimension, svm_float_t>::kernel_function_t&
+        kernel,
+    std::size_t ScreenSize, svm_float_t Margin, svm_float_t Tolerance,
+    std::size_t EpochLimit, svm_float_t ModifyLimit,
+    std::size_t FeedbackLimit, std::size_t seed, std::size_t Threads,
+    const DataCallback<std::size_t>& RoundCallback) {
+  using sample_t = Sample<Dimension, svm_float_t>;
+  std::vector<sample_t> subset(first, last);
+  std::ranges::shuffle(subset, std::mt19937(seed));
+  subset.resize(std::min(ScreenSize, subset.size()));
+
+  // 子样本上的核模型，不做回补
+  const auto screen = ScreenedSMO<Dimension, svm_float_t>(
+      subset.begin(), subset.end(), kernel,
+      [](const auto&) { return svm_float_t(0); }, svm_float_t(1), Tolerance,
+      EpochLimit, ModifyLimit, 0, seed, Threads);
+  // screen调用kernel，自定义核时第一阶段的打分也须串行
+  return ScreenedSMO<Dimension, svm_float_t>(
+      first, last, kernel,
+      [&](const auto& x) { return screen.Decision(x); }, Margin, Tolerance,
+      EpochLimit, ModifyLimit, FeedbackLimit, seed,
+      KernelThreads<Dimension, svm_float_t>(kernel, Threads), RoundCallback);
+}
+
+}  // namespace SVM
+
+#endif
\ No newline at end of file
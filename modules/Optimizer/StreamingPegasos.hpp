@@ -0,0 +1,155 @@
+#ifndef __SVM_STREAMING_PEGASOS_HPP__
+#define __SVM_STREAMING_PEGASOS_HPP__
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+#include "SVM/SVM.hpp"
+#include "Sample/Sample.hpp"
+#include "SegmentPlane/SegmentPlane.hpp"
+#include "common/common.hpp"
+
+namespace SVM {
+
+// 在线小批量Pegasos，适用于无界的样本流
+// 每凑满BatchSize个样本执行一步，第t步步长eta = 1 / (Lambda * t)：
+// w <- (1 - eta * Lambda) * w + eta / k * sum_{y * (w.x + b) < 1} y * x
+// bias视为值恒为1的额外维度一同正则化，之后将(w, b)投影到半径为
+// 1 / sqrt(Lambda)的球内；只保存一个批次的样本，内存占用恒定
+// 每步结束后发布快照，Snapshot可在其他线程随时调用，训练只在复制快照时短暂加锁
+// 除Snapshot、Steps与Samples外，其余成员只能由一个线程调用
+template <std::size_t Dimension, std::floating_point svm_float_t = double>
+class StreamingPegasos {
+  using sample_t = Sample<Dimension, svm_float_t>;
+
+  svm_float_t Lambda;
+  std::size_t BatchSize;
+  SegmentPlane<Dimension, svm_float_t> plane{{}, 0};
+  std::vector<sample_t> batch;
+  std::vector<svm_float_t> margin;
+  std::atomic<std::size_t> step = 0, consumed = 0;
+
+  mutable std::mutex snapshot_mutex;
+  SegmentPlane<Dimension, svm_float_t> snapshot{{}, 0};
+
+  void Step();
+
+ public:
+  explicit StreamingPegasos(svm_float_t Lambda = 1e-4,
+                            std::size_t BatchSize = 64);
+
+  void Push(const sample_t&);
+  template <std::input_iterator inputIt>
+  void Push(inputIt first, inputIt last);
+  // 反复调用source()取得样本，直至其返回std::nullopt，返回取得的样本数
+  template <class source_t>
+  std::size_t Consume(const source_t& source);
+  // 以不足BatchSize的剩余样本执行一步
+  void Flush();
+
+  // 最近一步结束时的模型
+  LinearSVM<Dimension, svm_float_t> Snapshot() const;
+  std::size_t Steps() const { return step; }
+  std::size_t Samples() const { return consumed; }
+};
+
+}  // namespace SVM
+
+//////////implementation//////////
+
+namespace SVM {
+
+template <std::size_t Dimension, std::floating_point svm_float_t>
+StreamingPegasos<Dimension, svm_float_t>::StreamingPegasos(
+    svm_float_t _Lambda, std::size_t _BatchSize)
+    : Lambda(_Lambda), BatchSize(std::max<std::size_t>(1, _BatchSize)) {
+  // Lambda非正时步长与投影半径均无意义
+  if (!(Lambda > 0))
+    throw std::runtime_error("Fail to train with non-positive Lambda.");
+  batch.reserve(BatchSize);
+  margin.resize(BatchSize);
+}
+
+template <std::size_t Dimension, std::floating_point svm_float_t>
+void StreamingPegasos<Dimension, svm_float_t>::Push(const sample_t& sample) {
+  batch.push_back(sample);
+  consumed.fetch_add(1, std::memory_order_relaxed);
+  if (batch.size() == BatchSize) Step();
+}
+
+template <std::size_t Dimension, std::floating_point svm_float_t>
+template <std::input_iterator inputIt>
+void StreamingPegasos<Dimension, svm_float_t>::Push(inputIt first,
+                                                    inputIt last) {
+  for (; first != last; ++first) Push(*first);
+}
+
+template <std::size_t Dimension, std::floating_point svm_float_t>
+template <class source_t>
+std::size_t StreamingPegasos<Dimension, svm_float_t>::Consume(
+    const source_t& source) {
+  std::size_t count = 0;
+  for (std::optional<sample_t> sample; (sample = source()); count++)
+    Push(*sample);
+  return count;
+}
+
+template <std::size_t Dimension, std::floating_point svm_float_t>
+void StreamingPegasos<Dimension, svm_float_t>::Flush() {
+  if (!batch.empty()) Step();
+}
+
+template <std::size_t Dimension, std::floating_point svm_float_t>
+void StreamingPegasos<Dimension, svm_float_t>::Step() {
+  const std::size_t k = batch.size();
+  const svm_float_t eta = 1 / (Lambda * svm_float_t(step + 1));
+
+  // 先以更新前的模型求出整批的间隔，再累加违反间隔样本的梯度
+  for (std::size_t i = 0; i < k; i++)
+    margin[i] = batch[i].classification *
+                (plane.weight.dot(batch[i].data) + plane.bias);
+  FixedVector<Dimension, svm_float_t> gradient{};
+  svm_float_t bias_gradient = 0;
+  for (std::size_t i = 0; i < k; i++) {
+    if (margin[i] >= 1) continue;
+    gradient.axpy(batch[i].classification, batch[i].data);
+    bias_gradient += batch[i].classification;
+  }
+
+  const svm_float_t shrink = 1 - eta * Lambda;
+  plane.weight *= shrink;
+  plane.weight.axpy(eta / k, gradient);
+  plane.bias = plane.bias * shrink + eta / k * bias_gradient;
+
+  // 最优解满足|(w, b)| <= 1 / sqrt(Lambda)
+  const svm_float_t norm =
+      std::sqrt(plane.weight.dot(plane.weight) + plane.bias * plane.bias);
+  const svm_float_t radius = 1 / std::sqrt(Lambda);
+  if (norm > radius) {
+    plane.weight *= radius / norm;
+    plane.bias *= radius / norm;
+  }
+
+  batch.clear();
+  std::lock_guard lock(snapshot_mutex);
+  snapshot = plane;
+  step.fetch_add(1, std::memory_order_relaxed);
+}
+
+template <std::size_t Dimension, std::floating_point svm_float_t>
+LinearSVM<Dimension, svm_float_t>
+StreamingPegasos<Dimension, svm_float_t>::Snapshot() const {
+  std::lock_guard lock(snapshot_mutex);
+  return LinearSVM<Dimension, svm_float_t>(snapshot);
+}
+
+}  // namespace SVM
+
+#endif
\ No newline at end of file
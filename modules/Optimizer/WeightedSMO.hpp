@@ -0,0 +1,109 @@
+#ifndef __SVM_WEIGHTED_SMO_HPP__
+#define __SVM_WEIGHTED_SMO_HPP__
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "DataSet/CoalescedDataSet.hpp"
+#include "KernelMatrix/KernelMatrix.hpp"
+#include "Optimizer/SMO.hpp"
+#include "SVM/SVM.hpp"
+#include "Sample/Sample.hpp"
+#include "common/Parallel.hpp"
+#include "common/common.hpp"
+
+namespace SVM {
+
+// 在运行时大小的加权样本上训练，第i个样本的lambda上界为Tolerance * weight[i]
+// 常与CoalesceSamples配合，以合并后的较小问题代替原问题
+// Threads只用于内置核，自定义核总在调用线程上串行计算，其余参数含义同SMO
+template <std::size_t Dimension, std::floating_point svm_float_t = double,
+          std::random_access_iterator randomIt,
+          std::random_access_iterator weightIt>
+CompactSVM<Dimension, svm_float_t> WeightedSMO(
+    randomIt first, randomIt last, weightIt weight,
+    const typename CompactSVM<Dimension, svm_float_t>::kernel_function_t&
+        kernel,
+    svm_float_t Tolerance, std::size_t EpochLimit, svm_float_t ModifyLimit,
+    std::size_t seed = 0, std::size_t Threads = DefaultThreads(),
+    const DataCallback<std::size_t>& EpochCallback = [](std::size_t) {},
+    const DataCallback<decltype(svm_float_t())>& ModifyCallback =
+        [](svm_float_t) {});
+
+template <std::size_t Dimension, std::floating_point svm_float_t>
+CompactSVM<Dimension, svm_float_t> WeightedSMO(
+    const CoalescedDataSet<Dimension, svm_float_t>& data,
+    const typename CompactSVM<Dimension, svm_float_t>::kernel_function_t&
+        kernel,
+    svm_float_t Tolerance, std::size_t EpochLimit, svm_float_t ModifyLimit,
+    std::size_t seed = 0, std::size_t Threads = DefaultThreads(),
+    const DataCallback<std::size_t>& EpochCallback = [](std::size_t) {},
+    const DataCallback<decltype(svm_float_t())>& ModifyCallback =
+        [](svm_float_t) {}) {
+  return WeightedSMO<Dimension, svm_float_t>(
+      data.sample.begin(), data.sample.end(), data.weight.begin(), kernel,
+      Tolerance, EpochLimit, ModifyLimit, seed, Threads, EpochCallback,
+      ModifyCallback);
+}
+
+}  // namespace SVM
+
+//////////implementation//////////
+
+namespace SVM {
+
+template <std::size_t Dimension, std::floating_point svm_float_t,
+          std::random_access_iterator randomIt,
+          std::random_access_iterator weightIt>
+CompactSVM<Dimension, svm_float_t> WeightedSMO(
+    randomIt first, randomIt last, weightIt weight,
+    const typename CompactSVM<Dimension, svm_float_t>::kernel_function_t&
+        kernel,
+    svm_float_t Tolerance, std::size_t EpochLimit, svm_float_t ModifyLimit,
+    std::size_t seed, std::size_t Threads,
+    const DataCallback<std::size_t>& EpochCallback,
+    const DataCallback<decltype(svm_float_t())>& ModifyCallback) {
+  const std::size_t n = last - first;
+  if (n == 0) throw std::runtime_error("Fail to train on no sample.");
+  auto label = [&](std::size_t i) { return first[i].classification; };
+  auto bound = [&](std::size_t i) {
+    return Tolerance * svm_float_t(weight[i]);
+  };
+  std::vector<svm_float_t> lambda(n);
+  SMOInitLambda(label, std::span<svm_float_t>(lambda), seed);
+
+  CompactSVM<Dimension, svm_float_t> result(kernel);
+  auto raw_kernel = [&](std::size_t i, std::size_t j) {
+    return kernel(first[i].data, first[j].data);
+  };
+  std::span<svm_float_t> span(lambda);
+  // 空间占用不大时预处理出运算结果
+  if (KernelMatrix<svm_float_t>::Bytes(n) <= MaxMemUsage) {
+    KernelMatrix<svm_float_t> kernel_save(n);
+    auto data = std::ranges::subrange(first, last) |
+                std::views::transform(
+                    [](const auto& s) -> const auto& { return s.data; });
+    // 只有内置核并行填充，自定义核串行调用，不要求其线程安全
+    if (!FillBuiltinKernel<Dimension>(kernel_save, kernel, data.begin(),
+                                      Threads))
+      kernel_save.Fill(raw_kernel, 1);
+    result.bias = WeightedSMOSolve(label, bound, kernel_save, span, EpochLimit,
+                                   ModifyLimit, EpochCallback, ModifyCallback);
+  } else
+    result.bias = WeightedSMOSolve(label, bound, raw_kernel, span, EpochLimit,
+                                   ModifyLimit, EpochCallback, ModifyCallback);
+
+  for (std::size_t i = 0; i < n; i++)
+    if (sgn(lambda[i]) != 0) {
+      result.support.push_back(first[i]);
+      result.lambda.push_back(lambda[i]);
+    }
+  return result;
+}
+
+}  // namespace SVM
+
+#endif
\ No newline at end of file
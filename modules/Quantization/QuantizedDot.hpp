@@ -0,0 +1,63 @@
+#ifndef __SVM_QUANTIZED_DOT_HPP__
+#define __SVM_QUANTIZED_DOT_HPP__
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+#include <cstddef>
+#include <cstdint>
+
+namespace SVM {
+
+#ifdef __FLT16_MAX__
+using half_t = _Float16;
+#else
+// 编译器不支持_Float16时以float存储
+using half_t = float;
+#endif
+
+// int8内积，按SIMD宽度整块计算，不足一块的尾部逐个累加
+inline int32_t DotInt8(const int8_t* a, const int8_t* b, std::size_t n) {
+  int32_t result = 0;
+  std::size_t i = 0;
+#if defined(__AVX512VNNI__) && defined(__AVX512BW__)
+  // vpdpbusd计算u8 * s8：将a异或0x80得到a + 128，再减去128 * sum(b)
+  const __m512i bias = _mm512_set1_epi8(char(0x80));
+  __m512i sum = _mm512_setzero_si512(), offset = _mm512_setzero_si512();
+  for (; i + 64 <= n; i += 64) {
+    const __m512i va = _mm512_xor_si512(_mm512_loadu_si512(a + i), bias);
+    const __m512i vb = _mm512_loadu_si512(b + i);
+    sum = _mm512_dpbusd_epi32(sum, va, vb);
+    offset = _mm512_dpbusd_epi32(offset, bias, vb);
+  }
+  result = _mm512_reduce_add_epi32(_mm512_sub_epi32(sum, offset));
+#elif defined(__AVX2__)
+  __m256i sum = _mm256_setzero_si256();
+  for (; i + 16 <= n; i += 16) {
+    const __m256i va = _mm256_cvtepi8_epi16(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)));
+    const __m256i vb = _mm256_cvtepi8_epi16(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i)));
+    sum = _mm256_add_epi32(sum, _mm256_madd_epi16(va, vb));
+  }
+  __m128i s = _mm_add_epi32(_mm256_castsi256_si128(sum),
+                            _mm256_extracti128_si256(sum, 1));
+  s = _mm_hadd_epi32(s, s);
+  s = _mm_hadd_epi32(s, s);
+  result = _mm_cvtsi128_si32(s);
+#endif
+  for (; i < n; i++) result += int32_t(a[i]) * b[i];
+  return result;
+}
+
+// 半精度向量与单精度向量的内积，以单精度累加
+inline float DotHalf(const half_t* a, const float* b, std::size_t n) {
+  float sum = 0;
+  for (std::size_t i = 0; i < n; i++) sum += float(a[i]) * b[i];
+  return sum;
+}
+
+}  // namespace SVM
+
+#endif
\ No newline at end of file
@@ -0,0 +1,226 @@
+#ifndef __SVM_QUANTIZED_SVM_HPP__
+#define __SVM_QUANTIZED_SVM_HPP__
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+#include "Kernel/LinearKernel.hpp"
+#include "Quantization/QuantizedDot.hpp"
+#include "SVM/SVM.hpp"
+#include "common/common.hpp"
+
+namespace SVM {
+
+enum class QuantizeMode {
+  Int8,    // 按特征缩放后量化为int8，以整数内积计算
+  Float16  // 以半精度存储支持向量
+};
+
+// 量化后的SVM，仅用于推理
+// 设第d维的缩放为s_d，则 a.x = sum (a_d * s_d) * (x_d / s_d)
+// 存储 a_d * s_d，查询时计算 x_d / s_d，两侧分别量化后求整数内积
+// 存储一侧的步长在构造时固定，查询一侧的步长随每次查询决定
+// 核模型的支持向量与查询同处数据空间，取s_d = 1；按维缩放会把各维
+// 值域的差距平方后压到一侧，使值域较小的维量化为零
+// Kernel需提供FromDot(a.b, |a|^2, |b|^2)，模长取自量化后的向量，
+// 以免与量化内积相减时误差被放大
+// 每个支持向量只存储Dimension个分量，不按SIMD宽度补齐
+template <std::size_t Dimension, class Kernel,
+          std::floating_point svm_float_t = double>
+class QuantizedSVM {
+  using data_t = FixedVector<Dimension, svm_float_t>;
+
+  QuantizeMode mode;
+  Kernel kernel;
+  data_t scale;
+  // int8模式下支持向量一侧的量化步长
+  svm_float_t step = 1;
+  std::vector<int8_t> support_int8;
+  std::vector<half_t> support_half;
+  std::vector<float> norm;
+  std::vector<float> coefficient;
+  svm_float_t bias;
+
+  void Build(const std::vector<data_t>&, const std::vector<svm_float_t>&);
+
+ public:
+  // 支持向量与查询均按原值量化
+  QuantizedSVM(const CompactSVM<Dimension, svm_float_t>&, const Kernel&,
+               QuantizeMode = QuantizeMode::Int8);
+  // 线性模型的权重不代表数据范围，需以[first, last)中的样本标定缩放
+  template <std::forward_iterator forwardIt>
+    requires std::same_as<Kernel, LinearKernel<Dimension, svm_float_t>>
+  QuantizedSVM(const LinearSVM<Dimension, svm_float_t>&, forwardIt first,
+               forwardIt last, QuantizeMode = QuantizeMode::Int8);
+
+  svm_float_t Decision(const data_t&) const;
+  ClassificationType operator()(const data_t&) const;
+  // 模型实际分配的字节数
+  std::size_t Bytes() const;
+  std::size_t Size() const { return coefficient.size(); }
+};
+
+// 量化模型与原模型在验证集上的对比
+struct QuantizationReport {
+  std::size_t count = 0;
+  // 分类结果一致的样本数
+  std::size_t agreement = 0;
+  double max_error = 0, mean_error = 0;
+};
+
+template <class Reference, class Quantized, std::forward_iterator forwardIt>
+QuantizationReport ValidateQuantization(const Reference&, const Quantized&,
+                                        forwardIt first, forwardIt last);
+
+}  // namespace SVM
+
+//////////implementation//////////
+
+namespace SVM {
+
+template <std::size_t Dimension, class Kernel, std::floating_point svm_float_t>
+QuantizedSVM<Dimension, Kernel, svm_float_t>::QuantizedSVM(
+    const CompactSVM<Dimension, svm_float_t>& svm, const Kernel& _kernel,
+    QuantizeMode _mode)
+    : mode(_mode), kernel(_kernel), bias(svm.bias) {
+  std::vector<data_t> support;
+  std::vector<svm_float_t> weight;
+  for (std::size_t i = 0; i < svm.support.size(); i++) {
+    support.push_back(svm.support[i].data);
+    weight.push_back(svm.lambda[i] * svm.support[i].classification);
+  }
+  for (std::size_t d = 0; d < Dimension; d++) scale[d] = 1;
+  Build(support, weight);
+}
+
+template <std::size_t Dimension, class Kernel, std::floating_point svm_float_t>
+template <std::forward_iterator forwardIt>
+  requires std::same_as<Kernel, LinearKernel<Dimension, svm_float_t>>
+QuantizedSVM<Dimension, Kernel, svm_float_t>::QuantizedSVM(
+    const LinearSVM<Dimension, svm_float_t>& svm, forwardIt first,
+    forwardIt last, QuantizeMode _mode)
+    : mode(_mode), bias(svm.segmentation.bias) {
+  for (std::size_t d = 0; d < Dimension; d++) scale[d] = 0;
+  for (; first != last; ++first)
+    for (std::size_t d = 0; d < Dimension; d++)
+      scale[d] = std::max(scale[d], std::abs((*first).data[d]));
+  Build({svm.segmentation.weight}, {1});
+}
+
+template <std::size_t Dimension, class Kernel, std::floating_point svm_float_t>
+void QuantizedSVM<Dimension, Kernel, svm_float_t>::Build(
+    const std::vector<data_t>& support,
+    const std::vector<svm_float_t>& weight) {
+  for (std::size_t d = 0; d < Dimension; d++)
+    if (scale[d] == 0) scale[d] = 1;
+
+  const std::size_t n = support.size();
+  coefficient.assign(weight.begin(), weight.end());
+  norm.assign(n, 0);
+  svm_float_t max_value = 0;
+  for (std::size_t i = 0; i < n; i++)
+    for (std::size_t d = 0; d < Dimension; d++)
+      max_value = std::max(max_value, std::abs(support[i][d] * scale[d]));
+
+  // 模长按反量化后的分量计算
+  if (mode == QuantizeMode::Int8) {
+    step = max_value == 0 ? 1 : max_value / 127;
+    support_int8.resize(n * Dimension);
+    for (std::size_t i = 0; i < n; i++)
+      for (std::size_t d = 0; d < Dimension; d++) {
+        int8_t& q = support_int8[i * Dimension + d];
+        q = int8_t(std::lround(support[i][d] * scale[d] / step));
+        const svm_float_t value = q * step / scale[d];
+        norm[i] += value * value;
+      }
+  } else {
+    support_half.resize(n * Dimension);
+    for (std::size_t i = 0; i < n; i++)
+      for (std::size_t d = 0; d < Dimension; d++) {
+        half_t& h = support_half[i * Dimension + d];
+        h = half_t(support[i][d] * scale[d]);
+        const svm_float_t value = svm_float_t(h) / scale[d];
+        norm[i] += value * value;
+      }
+  }
+}
+
+template <std::size_t Dimension, class Kernel, std::floating_point svm_float_t>
+svm_float_t QuantizedSVM<Dimension, Kernel, svm_float_t>::Decision(
+    const data_t& data) const {
+  svm_float_t result = bias, norm_x = 0;
+  if (mode == QuantizeMode::Int8) {
+    // 查询一侧按自身的最大值动态决定步长，超出标定范围时也不会截断
+    svm_float_t query_max = 0;
+    for (std::size_t d = 0; d < Dimension; d++)
+      query_max = std::max(query_max, std::abs(data[d] / scale[d]));
+    const svm_float_t query_step = query_max == 0 ? 1 : query_max / 127;
+    int8_t query[Dimension];
+    for (std::size_t d = 0; d < Dimension; d++) {
+      query[d] = int8_t(std::lround(data[d] / scale[d] / query_step));
+      const svm_float_t value = query[d] * query_step * scale[d];
+      norm_x += value * value;
+    }
+    const svm_float_t unit = step * query_step;
+    for (std::size_t i = 0; i < coefficient.size(); i++) {
+      const svm_float_t dot =
+          DotInt8(support_int8.data() + i * Dimension, query, Dimension) *
+          unit;
+      result += coefficient[i] * kernel.FromDot(dot, norm[i], norm_x);
+    }
+  } else {
+    float query[Dimension];
+    for (std::size_t d = 0; d < Dimension; d++) {
+      query[d] = data[d] / scale[d];
+      const svm_float_t value = query[d] * scale[d];
+      norm_x += value * value;
+    }
+    for (std::size_t i = 0; i < coefficient.size(); i++) {
+      const svm_float_t dot =
+          DotHalf(support_half.data() + i * Dimension, query, Dimension);
+      result += coefficient[i] * kernel.FromDot(dot, norm[i], norm_x);
+    }
+  }
+  return result;
+}
+
+template <std::size_t Dimension, class Kernel, std::floating_point svm_float_t>
+ClassificationType QuantizedSVM<Dimension, Kernel, svm_float_t>::operator()(
+    const data_t& data) const {
+  return sgn(Decision(data));
+}
+
+template <std::size_t Dimension, class Kernel, std::floating_point svm_float_t>
+std::size_t QuantizedSVM<Dimension, Kernel, svm_float_t>::Bytes() const {
+  return support_int8.capacity() * sizeof(int8_t) +
+         support_half.capacity() * sizeof(half_t) +
+         (norm.capacity() + coefficient.capacity()) * sizeof(float) +
+         sizeof(*this);
+}
+
+template <class Reference, class Quantized, std::forward_iterator forwardIt>
+QuantizationReport ValidateQuantization(const Reference& reference,
+                                        const Quantized& quantized,
+                                        forwardIt first, forwardIt last) {
+  QuantizationReport report;
+  for (; first != last; ++first) {
+    const auto& data = (*first).data;
+    const double expect = reference.Decision(data),
+                 actual = quantized.Decision(data);
+    const double error = std::abs(expect - actual);
+    report.count++;
+    report.agreement += sgn(expect) == sgn(actual);
+    report.max_error = std::max(report.max_error, error);
+    report.mean_error += error;
+  }
+  if (report.count) report.mean_error /= report.count;
+  return report;
+}
+
+}  // namespace SVM
+
+#endif
\ No newline at end of file
@@ -0,0 +1,144 @@
+#ifndef __SVM_RASTER_HPP__
+#define __SVM_RASTER_HPP__
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <iterator>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "common/Parallel.hpp"
+#include "common/common.hpp"
+
+namespace SVM {
+
+// Dimension维网格，第d维在[lower[d], upper[d])上等分为slice[d]个点
+// 下标按行优先展开，最后一维变化最快
+template <std::size_t Dimension, std::floating_point svm_float_t = double>
+struct Grid {
+  FixedVector<Dimension, svm_float_t> lower, upper;
+  std::array<std::size_t, Dimension> slice;
+
+  std::size_t Size() const {
+    std::size_t size = 1;
+    for (auto s : slice) size *= s;
+    return size;
+  }
+  FixedVector<Dimension, svm_float_t> operator[](std::size_t index) const {
+    FixedVector<Dimension, svm_float_t> point;
+    for (std::size_t d = Dimension; d-- > 0;) {
+      point[d] = lower[d] + (upper[d] - lower[d]) *
+                                (svm_float_t(index % slice[d]) / slice[d]);
+      index /= slice[d];
+    }
+    return point;
+  }
+};
+
+enum class RasterFormat {
+  CSV,    // 每行一个结果
+  Binary  // 结果的原始字节连续写出
+};
+
+// 每个任务处理的点数
+const std::size_t RasterTileSize = 1 << 10;
+// 写出到流时每批计算并缓冲的点数
+const std::size_t RasterChunkSize = 1 << 18;
+
+// 对[first, last)中的查询点分块并行求值，结果依次写入output
+template <class Model, std::random_access_iterator randomIt,
+          std::random_access_iterator outputIt>
+void PredictBatch(const Model&, randomIt first, randomIt last, outputIt output,
+                  std::size_t Threads = DefaultThreads());
+
+// 对网格上所有点分块并行求值，结果依次写入output
+template <class Model, std::size_t Dimension, std::floating_point svm_float_t,
+          std::random_access_iterator outputIt>
+void Rasterize(const Model&, const Grid<Dimension, svm_float_t>&,
+               outputIt output, std::size_t Threads = DefaultThreads());
+
+// 对网格上所有点分批并行求值，每批格式化后以一次大块写入输出到流
+template <class Model, std::size_t Dimension, std::floating_point svm_float_t>
+void Rasterize(const Model&, const Grid<Dimension, svm_float_t>&,
+               std::ostream&, RasterFormat = RasterFormat::CSV,
+               std::size_t Threads = DefaultThreads());
+
+}  // namespace SVM
+
+//////////implementation//////////
+
+namespace SVM {
+
+template <class Model, std::random_access_iterator randomIt,
+          std::random_access_iterator outputIt>
+void PredictBatch(const Model& model, randomIt first, randomIt last,
+                  outputIt output, std::size_t Threads) {
+  const std::size_t n = last - first;
+  ParallelFor(
+      (n + RasterTileSize - 1) / RasterTileSize,
+      [&](std::size_t tile) {
+        const std::size_t end = std::min(n, (tile + 1) * RasterTileSize);
+        for (std::size_t i = tile * RasterTileSize; i < end; i++)
+          output[i] = model(first[i]);
+      },
+      Threads);
+}
+
+template <class Model, std::size_t Dimension, std::floating_point svm_float_t,
+          std::random_access_iterator outputIt>
+void Rasterize(const Model& model, const Grid<Dimension, svm_float_t>& grid,
+               outputIt output, std::size_t Threads) {
+  const std::size_t n = grid.Size();
+  ParallelFor(
+      (n + RasterTileSize - 1) / RasterTileSize,
+      [&](std::size_t tile) {
+        const std::size_t end = std::min(n, (tile + 1) * RasterTileSize);
+        for (std::size_t i = tile * RasterTileSize; i < end; i++)
+          output[i] = model(grid[i]);
+      },
+      Threads);
+}
+
+template <class Model, std::size_t Dimension, std::floating_point svm_float_t>
+void Rasterize(const Model& model, const Grid<Dimension, svm_float_t>& grid,
+               std::ostream& out, RasterFormat format, std::size_t Threads) {
+  using output_t = std::decay_t<decltype(model(grid[0]))>;
+  const std::size_t n = grid.Size();
+  std::vector<output_t> value;
+  std::string buffer;
+  for (std::size_t begin = 0; begin < n; begin += RasterChunkSize) {
+    const std::size_t size = std::min(RasterChunkSize, n - begin);
+    value.resize(size);
+    ParallelFor(
+        (size + RasterTileSize - 1) / RasterTileSize,
+        [&](std::size_t tile) {
+          const std::size_t end = std::min(size, (tile + 1) * RasterTileSize);
+          for (std::size_t i = tile * RasterTileSize; i < end; i++)
+            value[i] = model(grid[begin + i]);
+        },
+        Threads);
+
+    if (format == RasterFormat::Binary) {
+      out.write(reinterpret_cast<const char*>(value.data()),
+                size * sizeof(output_t));
+      continue;
+    }
+    buffer.clear();
+    char text[64];
+    for (const auto& v : value) {
+      auto [end, ec] = std::to_chars(text, text + sizeof(text), v);
+      buffer.append(text, end);
+      buffer.push_back('\n');
+    }
+    out.write(buffer.data(), buffer.size());
+  }
+  out.flush();
+}
+
+}  // namespace SVM
+
+#endif
\ No newline at end of file
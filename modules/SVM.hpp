@@ -2,12 +2,49 @@
 #define __SVM_HPP__
 
 #include "DataLoader/BreastCancerWisconsinLoader.hpp"
+#include "DataSet/CoalescedDataSet.hpp"
+#include "DataSet/MappedDataSet.hpp"
+#include "DataSet/MappedGramMatrix.hpp"
+#include "FeatureMap/ApproximateKernelSVM.hpp"
+#include "FeatureMap/NystroemFeature.hpp"
+#include "FeatureMap/RandomFourierFeature.hpp"
+#include "Kernel/BuiltinKernel.hpp"
+#include "Kernel/LinearKernel.hpp"
+#include "Kernel/PolynomialKernel.hpp"
+#include "Kernel/RBFKernel.hpp"
+#include "Kernel/SigmoidKernel.hpp"
+#include "KernelMatrix/KernelMatrix.hpp"
+#include "Normalization/Normalizer.hpp"
+#include "Optimizer/CascadeSMO.hpp"
 #include "Optimizer/LinearSMO.hpp"
+#include "Optimizer/OutOfCoreSMO.hpp"
+#include "Optimizer/ParallelDCD.hpp"
+#include "Optimizer/PrecomputedSMO.hpp"
 #include "Optimizer/SMO.hpp"
+#include "Optimizer/ScreenedSMO.hpp"
+#include "Optimizer/StreamingPegasos.hpp"
+#include "Optimizer/WeightedSMO.hpp"
+#include "Quantization/QuantizedDot.hpp"
+#include "Quantization/QuantizedSVM.hpp"
+#include "Raster/Raster.hpp"
+#include "SVM/BudgetedSVM.hpp"
+#include "SVM/ModelFile.hpp"
+#include "SVM/NormalizedSVM.hpp"
+#include "SVM/PolynomialSVM.hpp"
+#include "SVM/PrecomputedSVM.hpp"
+#include "SVM/PrunedRBFSVM.hpp"
 #include "SVM/SVM.hpp"
+#include "SVM/SVMBundle.hpp"
 #include "Sample/Sample.hpp"
+#include "Server/ModelRegistry.hpp"
+#include "Server/PredictionClient.hpp"
+#include "Server/PredictionServer.hpp"
+#include "Server/Protocol.hpp"
 #include "TestSampleGenerator/LinearTestSampleGenerator.hpp"
 #include "TestSampleGenerator/MoonTestSampleGenerator.hpp"
+#include "common/FastMath.hpp"
+#include "common/Parallel.hpp"
+#include "common/Philox.hpp"
 #include "common/common.hpp"
 
 #endif
\ No newline at end of file
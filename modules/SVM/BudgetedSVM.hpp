@@ -0,0 +1,180 @@
+#ifndef __SVM_BUDGETED_SVM_HPP__
+#define __SVM_BUDGETED_SVM_HPP__
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <numeric>
+#include <vector>
+
+#include "Kernel/BuiltinKernel.hpp"
+#include "SVM/SVM.hpp"
+#include "common/Parallel.hpp"
+#include "common/common.hpp"
+
+namespace SVM {
+
+// 将模型缩减至至多Budget个支持向量，预测开销随之有固定上界
+// 将原模型在核函数空间中的法向量投影到剩余支持向量张成的子空间上，
+// 即求解 K_SS * beta = K_SA * alpha 重新得到系数；bias保持不变
+// 每轮移除投影误差增量最小的一部分支持向量后重新投影
+// 投影后的系数可能与原标签异号，此时lambda为负，决策函数值仍然正确
+// Jitter加在K_SS对角线上，保证支持向量重复时仍然正定
+// 自定义核总在调用线程上串行计算，不要求其线程安全
+template <std::size_t Dimension, std::floating_point svm_float_t>
+CompactSVM<Dimension, svm_float_t> BudgetSVM(
+    const CompactSVM<Dimension, svm_float_t>&, std::size_t Budget,
+    svm_float_t Jitter = 1e-8, std::size_t Threads = DefaultThreads());
+
+struct BudgetReport {
+  std::size_t count = 0;
+  std::size_t support_before = 0, support_after = 0;
+  // 分类正确的样本数
+  std::size_t correct_before = 0, correct_after = 0;
+  // 两模型分类结果一致的样本数
+  std::size_t agreement = 0;
+  double max_error = 0, mean_error = 0;
+};
+
+// 在带标签样本[first, last)上比较缩减前后的模型
+template <std::size_t Dimension, std::floating_point svm_float_t,
+          std::forward_iterator forwardIt>
+BudgetReport ValidateBudget(const CompactSVM<Dimension, svm_float_t>&,
+                            const CompactSVM<Dimension, svm_float_t>&,
+                            forwardIt first, forwardIt last);
+
+}  // namespace SVM
+
+//////////implementation//////////
+
+namespace SVM {
+
+template <std::size_t Dimension, std::floating_point svm_float_t>
+CompactSVM<Dimension, svm_float_t> BudgetSVM(
+    const CompactSVM<Dimension, svm_float_t>& svm, std::size_t Budget,
+    svm_float_t Jitter, std::size_t Threads) {
+  const std::size_t n = svm.support.size();
+  if (n <= Budget) return svm;
+
+  // alpha_i = lambda_i * y_i，为原模型的系数
+  std::vector<svm_float_t> alpha(n);
+  for (std::size_t i = 0; i < n; i++)
+    alpha[i] = svm.lambda[i] * svm.support[i].classification;
+
+  std::vector<std::size_t> kept(n);
+  std::iota(kept.begin(), kept.end(), 0);
+  std::vector<svm_float_t> beta, L;
+  const std::size_t kernel_threads =
+      KernelThreads<Dimension, svm_float_t>(svm.kernel, Threads);
+  for (;;) {
+    const std::size_t m = kept.size();
+    // 右端项 b_i = sum_j K(x_i, x_j) * alpha_j，与K_SS的下三角一同按行并行计算
+    beta.assign(m, 0);
+    L.assign(m * m, 0);
+    ParallelFor(
+        m,
+        [&](std::size_t i) {
+          const auto& x = svm.support[kept[i]].data;
+          svm_float_t s = 0;
+          for (std::size_t j = 0; j < n; j++)
+            s += svm.kernel(x, svm.support[j].data) * alpha[j];
+          beta[i] = s;
+          for (std::size_t j = 0; j <= i; j++)
+            L[i * m + j] = svm.kernel(x, svm.support[kept[j]].data);
+        },
+        kernel_threads);
+    // 原地Cholesky分解 K_SS + Jitter * I = L * L^T
+    for (std::size_t i = 0; i < m; i++)
+      for (std::size_t j = 0; j <= i; j++) {
+        svm_float_t s = L[i * m + j];
+        for (std::size_t k = 0; k < j; k++) s -= L[i * m + k] * L[j * m + k];
+        if (i == j)
+          L[i * m + i] = std::sqrt(std::max(s, svm_float_t(0)) + Jitter);
+        else
+          L[i * m + j] = s / L[j * m + j];
+      }
+    // 前代求解 L * z = b，再回代求解 L^T * beta = z
+    for (std::size_t i = 0; i < m; i++) {
+      for (std::size_t k = 0; k < i; k++) beta[i] -= L[i * m + k] * beta[k];
+      beta[i] /= L[i * m + i];
+    }
+    for (std::size_t i = m; i-- > 0;) {
+      for (std::size_t k = i + 1; k < m; k++) beta[i] -= L[k * m + i] * beta[k];
+      beta[i] /= L[i * m + i];
+    }
+    if (m <= Budget) break;
+
+    // 单独移除第j个支持向量并重新投影后，法向量的变化量平方为
+    // beta_j^2 / (K_SS^-1)_jj；(K_SS^-1)_jj为L^-1第j列的平方和
+    // L^-1的各列相互独立，逐列前代求出后即累加，不保存整个逆矩阵
+    std::vector<svm_float_t> inverse_diagonal(m, 0);
+    ParallelFor(
+        m,
+        [&](std::size_t j) {
+          std::vector<svm_float_t> column(m - j);
+          for (std::size_t i = j; i < m; i++) {
+            svm_float_t s = i == j ? 1 : 0;
+            for (std::size_t k = j; k < i; k++)
+              s -= L[i * m + k] * column[k - j];
+            column[i - j] = s / L[i * m + i];
+            inverse_diagonal[j] += column[i - j] * column[i - j];
+          }
+        },
+        Threads);
+
+    // 每轮移除超出部分的一半，使投影次数为对数级
+    const std::size_t remove = std::max<std::size_t>(1, (m - Budget + 1) / 2);
+    std::vector<std::size_t> order(m);
+    std::iota(order.begin(), order.end(), 0);
+    auto loss = [&](std::size_t j) {
+      return beta[j] * beta[j] / inverse_diagonal[j];
+    };
+    std::ranges::nth_element(
+        order, order.begin() + remove,
+        [&](std::size_t a, std::size_t b) { return loss(a) < loss(b); });
+    std::vector<char> removed(m, 0);
+    for (std::size_t k = 0; k < remove; k++) removed[order[k]] = 1;
+    std::vector<std::size_t> next;
+    for (std::size_t k = 0; k < m; k++)
+      if (!removed[k]) next.push_back(kept[k]);
+    kept = std::move(next);
+  }
+
+  CompactSVM<Dimension, svm_float_t> result(svm.kernel);
+  result.bias = svm.bias;
+  for (std::size_t k = 0; k < kept.size(); k++) {
+    if (beta[k] == 0) continue;
+    const auto& sample = svm.support[kept[k]];
+    result.support.push_back(sample);
+    result.lambda.push_back(beta[k] * sample.classification);
+  }
+  return result;
+}
+
+template <std::size_t Dimension, std::floating_point svm_float_t,
+          std::forward_iterator forwardIt>
+BudgetReport ValidateBudget(const CompactSVM<Dimension, svm_float_t>& reference,
+                            const CompactSVM<Dimension, svm_float_t>& budgeted,
+                            forwardIt first, forwardIt last) {
+  BudgetReport report;
+  report.support_before = reference.support.size();
+  report.support_after = budgeted.support.size();
+  for (; first != last; ++first) {
+    const auto& [y, x] = *first;
+    const double expect = reference.Decision(x), actual = budgeted.Decision(x);
+    const double error = std::abs(expect - actual);
+    report.count++;
+    report.correct_before += sgn(expect) == y;
+    report.correct_after += sgn(actual) == y;
+    report.agreement += sgn(expect) == sgn(actual);
+    report.max_error = std::max(report.max_error, error);
+    report.mean_error += error;
+  }
+  if (report.count) report.mean_error /= report.count;
+  return report;
+}
+
+}  // namespace SVM
+
+#endif
\ No newline at end of file
@@ -0,0 +1,179 @@
+#ifndef __SVM_MODEL_FILE_HPP__
+#define __SVM_MODEL_FILE_HPP__
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+#include "Kernel/BuiltinKernel.hpp"
+#include "SVM/SVM.hpp"
+#include "common/common.hpp"
+
+namespace SVM {
+
+enum class KernelType : uint64_t { Linear, Polynomial, RBF, Sigmoid };
+
+// 模型文件头，其后依次为各支持向量的分类(int32)、数据与lambda
+struct ModelHeader {
+  char magic[8] = {'S', 'V', 'M', 'M', 'O', 'D', 'E', 'L'};
+  uint64_t dimension = 0;
+  uint64_t float_size = 0;
+  KernelType kernel = KernelType::Linear;
+  // Polynomial: Degree, Scale, Coef0
+  // RBF: Width
+  // Sigmoid: Scale, Coef0
+  double parameter[3] = {};
+  FastMathAccuracy accuracy = FastMathAccuracy::High;
+  uint64_t support = 0;
+  double bias = 0;
+};
+
+// 只能保存核函数为内置核的模型
+template <std::size_t Dimension, std::floating_point svm_float_t>
+void SaveModel(std::ostream&, const CompactSVM<Dimension, svm_float_t>&);
+// 读出的模型核函数包装内置核，可继续被VisitBuiltinKernel识别
+template <std::size_t Dimension, std::floating_point svm_float_t = double>
+CompactSVM<Dimension, svm_float_t> LoadModel(std::istream&);
+
+}  // namespace SVM
+
+//////////implementation//////////
+
+namespace SVM {
+
+template <std::size_t Dimension, std::floating_point svm_float_t>
+void SaveModel(std::ostream& os,
+               const CompactSVM<Dimension, svm_float_t>& svm) {
+  // 值初始化，使写出的填充字节为零
+  ModelHeader header{};
+  header.dimension = Dimension;
+  header.float_size = sizeof(svm_float_t);
+  header.support = svm.support.size();
+  header.bias = svm.bias;
+  const bool builtin = VisitBuiltinKernel<Dimension, svm_float_t>(
+      svm.kernel, [&]<class Kernel>(const Kernel& kernel) {
+        if constexpr (std::is_same_v<Kernel,
+                                     LinearKernel<Dimension, svm_float_t>>)
+          header.kernel = KernelType::Linear;
+        else if constexpr (std::is_same_v<
+                               Kernel,
+                               PolynomialKernel<Dimension, svm_float_t>>) {
+          header.kernel = KernelType::Polynomial;
+          header.parameter[0] = kernel.Degree;
+          header.parameter[1] = kernel.Scale;
+          header.parameter[2] = kernel.Coef0;
+        } else if constexpr (std::is_same_v<
+                                 Kernel, RBFKernel<Dimension, svm_float_t>>) {
+          header.kernel = KernelType::RBF;
+          header.parameter[0] = kernel.Width;
+          header.accuracy = kernel.Accuracy;
+        } else {
+          header.kernel = KernelType::Sigmoid;
+          header.parameter[0] = kernel.Scale;
+          header.parameter[1] = kernel.Coef0;
+          header.accuracy = kernel.Accuracy;
+        }
+      });
+  if (!builtin)
+    throw std::runtime_error("Fail to save model with a custom kernel.");
+
+  os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  for (std::size_t i = 0; i < svm.support.size(); i++) {
+    const auto& [y, x] = svm.support[i];
+    const int32_t classification = y;
+    os.write(reinterpret_cast<const char*>(&classification),
+             sizeof(classification));
+    for (std::size_t d = 0; d < Dimension; d++)
+      os.write(reinterpret_cast<const char*>(&x[d]), sizeof(svm_float_t));
+    os.write(reinterpret_cast<const char*>(&svm.lambda[i]),
+             sizeof(svm_float_t));
+  }
+  if (!os) throw std::runtime_error("Fail to write model.");
+}
+
+template <std::size_t Dimension, std::floating_point svm_float_t>
+CompactSVM<Dimension, svm_float_t> LoadModel(std::istream& is) {
+  ModelHeader header;
+  is.read(reinterpret_cast<char*>(&header), sizeof(header));
+  if (!is || std::memcmp(header.magic, ModelHeader().magic, 8) != 0 ||
+      header.dimension != Dimension ||
+      header.float_size != sizeof(svm_float_t) ||
+      (header.accuracy != FastMathAccuracy::Low &&
+       header.accuracy != FastMathAccuracy::Medium &&
+       header.accuracy != FastMathAccuracy::High))
+    throw std::runtime_error("Mismatched model.");
+
+  using kernel_function_t =
+      typename CompactSVM<Dimension, svm_float_t>::kernel_function_t;
+  kernel_function_t kernel;
+  const double* p = header.parameter;
+  switch (header.kernel) {
+    case KernelType::Linear:
+      kernel = LinearKernel<Dimension, svm_float_t>{};
+      break;
+    case KernelType::Polynomial:
+      // 次数须为可表示的非负整数，NaN不满足下面的比较
+      if (!(p[0] >= 0 && p[0] <= std::numeric_limits<uint32_t>::max() &&
+            p[0] == std::floor(p[0])))
+        throw std::runtime_error("Mismatched model.");
+      kernel = PolynomialKernel<Dimension, svm_float_t>{
+          std::size_t(p[0]), svm_float_t(p[1]), svm_float_t(p[2])};
+      break;
+    case KernelType::RBF:
+      kernel = RBFKernel<Dimension, svm_float_t>{svm_float_t(p[0]),
+                                                 header.accuracy};
+      break;
+    case KernelType::Sigmoid:
+      kernel = SigmoidKernel<Dimension, svm_float_t>{
+          svm_float_t(p[0]), svm_float_t(p[1]), header.accuracy};
+      break;
+    default:
+      throw std::runtime_error("Unknown kernel type in model.");
+  }
+
+  // 文件头中的数量不可信，可定位的流先以剩余长度检查，
+  // 避免为损坏的文件分配大量内存；不可定位的流逐条读取并检查
+  const std::size_t record =
+      sizeof(int32_t) + (Dimension + 1) * sizeof(svm_float_t);
+  bool verified = false;
+  if (const auto begin = is.tellg(); begin != std::istream::pos_type(-1)) {
+    is.seekg(0, std::ios::end);
+    const std::streamoff remaining = is.tellg() - begin;
+    is.seekg(begin);
+    if (!is || remaining < 0 || uint64_t(remaining) / record < header.support)
+      throw std::runtime_error("Truncated model.");
+    verified = true;
+  }
+
+  CompactSVM<Dimension, svm_float_t> svm(kernel);
+  svm.bias = header.bias;
+  if (verified) {
+    svm.support.reserve(header.support);
+    svm.lambda.reserve(header.support);
+  }
+  for (uint64_t i = 0; i < header.support; i++) {
+    Sample<Dimension, svm_float_t> sample;
+    svm_float_t lambda;
+    int32_t classification;
+    is.read(reinterpret_cast<char*>(&classification), sizeof(classification));
+    for (std::size_t d = 0; d < Dimension; d++)
+      is.read(reinterpret_cast<char*>(&sample.data[d]), sizeof(svm_float_t));
+    is.read(reinterpret_cast<char*>(&lambda), sizeof(svm_float_t));
+    if (!is) throw std::runtime_error("Truncated model.");
+    if (classification != 1 && classification != -1)
+      throw std::runtime_error("Invalid label in model.");
+    sample.classification = classification;
+    svm.support.push_back(sample);
+    svm.lambda.push_back(lambda);
+  }
+  return svm;
+}
+
+}  // namespace SVM
+
+#endif
\ No newline at end of file
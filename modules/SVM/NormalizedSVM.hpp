@@ -0,0 +1,92 @@
+#ifndef __SVM_NORMALIZED_SVM_HPP__
+#define __SVM_NORMALIZED_SVM_HPP__
+
+#include <cstddef>
+#include <iostream>
+#include <vector>
+
+#include "Normalization/Normalizer.hpp"
+#include "SVM/SVM.hpp"
+#include "common/common.hpp"
+
+namespace SVM {
+
+// 在归一化特征上训练的核SVM，直接对原始特征打分
+// 记x' = x * s + o，则 x'.v = x.(v * s) + o.v
+// 支持向量预先乘以s，每个查询只需额外计算一次|x'|^2，不产生归一化后的副本
+// Kernel需提供FromDot(a.b, |a|^2, |b|^2)
+template <std::size_t Dimension, class Kernel,
+          std::floating_point svm_float_t = double>
+class NormalizedSVM {
+  using data_t = FixedVector<Dimension, svm_float_t>;
+
+  Normalizer<Dimension, svm_float_t> normalizer;
+  Kernel kernel;
+  // v * s
+  std::vector<data_t> support;
+  // o.v
+  std::vector<svm_float_t> shift;
+  // |v|^2
+  std::vector<svm_float_t> norm;
+  std::vector<svm_float_t> coefficient;
+  svm_float_t bias;
+
+ public:
+  NormalizedSVM(const CompactSVM<Dimension, svm_float_t>&,
+                const Normalizer<Dimension, svm_float_t>&, const Kernel&);
+
+  const Normalizer<Dimension, svm_float_t>& Transform() const {
+    return normalizer;
+  }
+  svm_float_t Decision(const data_t&) const;
+  ClassificationType operator()(const data_t&) const;
+};
+
+}  // namespace SVM
+
+//////////implementation//////////
+
+namespace SVM {
+
+template <std::size_t Dimension, class Kernel, std::floating_point svm_float_t>
+NormalizedSVM<Dimension, Kernel, svm_float_t>::NormalizedSVM(
+    const CompactSVM<Dimension, svm_float_t>& svm,
+    const Normalizer<Dimension, svm_float_t>& _normalizer,
+    const Kernel& _kernel)
+    : normalizer(_normalizer), kernel(_kernel), bias(svm.bias) {
+  for (std::size_t i = 0; i < svm.support.size(); i++) {
+    const auto& [y, v] = svm.support[i];
+    data_t u;
+    for (std::size_t d = 0; d < Dimension; d++)
+      u[d] = v[d] * normalizer.scale[d];
+    support.push_back(u);
+    shift.push_back(normalizer.offset.dot(v));
+    norm.push_back(v.dot(v));
+    coefficient.push_back(svm.lambda[i] * y);
+  }
+}
+
+template <std::size_t Dimension, class Kernel, std::floating_point svm_float_t>
+svm_float_t NormalizedSVM<Dimension, Kernel, svm_float_t>::Decision(
+    const data_t& data) const {
+  svm_float_t norm_x = 0;
+  for (std::size_t d = 0; d < Dimension; d++) {
+    const svm_float_t x = data[d] * normalizer.scale[d] + normalizer.offset[d];
+    norm_x += x * x;
+  }
+  svm_float_t result = bias;
+  for (std::size_t i = 0; i < support.size(); i++)
+    result += coefficient[i] * kernel.FromDot(support[i].dot(data) + shift[i],
+                                              norm[i], norm_x);
+  return result;
+}
+
+template <std::size_t Dimension, class Kernel, std::floating_point svm_float_t>
+ClassificationType NormalizedSVM<Dimension, Kernel, svm_float_t>::operator()(
+    const data_t& data) const {
+  return sgn(Decision(data));
+}
+
+}  // namespace SVM
+
+#endif
\ No newline at end of file
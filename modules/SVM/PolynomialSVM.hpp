@@ -0,0 +1,125 @@
+#ifndef __SVM_POLYNOMIAL_SVM_HPP__
+#define __SVM_POLYNOMIAL_SVM_HPP__
+
+#include <cmath>
+#include <cstddef>
+#include <numeric>
+#include <vector>
+
+#include "Kernel/PolynomialKernel.hpp"
+#include "SVM/SVM.hpp"
+#include "common/common.hpp"
+
+namespace SVM {
+
+// 将多项式核SVM的支持向量合并为各单项式的系数
+// 预测代价为O(C(Dimension + Degree, Degree))，与支持向量数量无关
+template <std::size_t Dimension, std::floating_point svm_float_t = double>
+struct PolynomialSVM {
+  using data_t = FixedVector<Dimension, svm_float_t>;
+
+  // 单项式按次数递增排列，第k项等于第parent[k]项乘以x[variable[k]]
+  std::vector<std::size_t> parent, variable;
+  std::vector<svm_float_t> coefficient;
+  svm_float_t bias;
+
+  PolynomialSVM() = delete;
+  PolynomialSVM(const CompactSVM<Dimension, svm_float_t>&,
+                const PolynomialKernel<Dimension, svm_float_t>&);
+  template <std::size_t DataSetSize>
+  PolynomialSVM(const SVM<DataSetSize, Dimension, svm_float_t>& svm,
+                const PolynomialKernel<Dimension, svm_float_t>& kernel)
+      : PolynomialSVM(CompactSVM<Dimension, svm_float_t>(svm), kernel) {}
+
+  svm_float_t Decision(const data_t&) const;
+  ClassificationType operator()(const data_t&) const;
+
+ private:
+  void Monomial(const data_t&, std::vector<svm_float_t>&) const;
+};
+
+}  // namespace SVM
+
+//////////Implementation//////////
+
+namespace SVM {
+
+template <std::size_t Dimension, std::floating_point svm_float_t>
+PolynomialSVM<Dimension, svm_float_t>::PolynomialSVM(
+    const CompactSVM<Dimension, svm_float_t>& svm,
+    const PolynomialKernel<Dimension, svm_float_t>& kernel)
+    : bias(svm.bias) {
+  const std::size_t Degree = kernel.Degree;
+  // 以不降的变量序列枚举单项式，同时记录次数与多项式系数k!/prod(a_j!)
+  std::vector<std::size_t> degree{0}, power{0};
+  std::vector<svm_float_t> multinomial{1};
+  parent = {0};
+  variable = {0};
+  for (std::size_t begin = 0, end = 1; begin != end;) {
+    std::size_t next_end = parent.size();
+    for (std::size_t k = begin; k < end; k++) {
+      if (degree[k] == Degree) continue;
+      for (std::size_t v = k == 0 ? 0 : variable[k]; v < Dimension; v++) {
+        // power记录末尾变量的连续重复次数，即该变量的指数
+        const std::size_t p = (k != 0 && v == variable[k]) ? power[k] + 1 : 1;
+        parent.push_back(k);
+        variable.push_back(v);
+        degree.push_back(degree[k] + 1);
+        power.push_back(p);
+        multinomial.push_back(multinomial[k] * (degree[k] + 1) / p);
+        next_end++;
+      }
+    }
+    begin = end;
+    end = next_end;
+  }
+
+  // (s * a.b + c)^p = sum_k C(p, k) c^(p - k) s^k (a.b)^k
+  std::vector<svm_float_t> factor(Degree + 1);
+  for (std::size_t k = 0; k <= Degree; k++) {
+    svm_float_t binomial = 1;
+    for (std::size_t t = 0; t < k; t++)
+      binomial = binomial * (Degree - t) / (t + 1);
+    factor[k] = binomial * std::pow(kernel.Coef0, svm_float_t(Degree - k)) *
+                std::pow(kernel.Scale, svm_float_t(k));
+  }
+
+  coefficient.assign(parent.size(), 0);
+  std::vector<svm_float_t> monomial;
+  for (std::size_t i = 0; i < svm.support.size(); i++) {
+    Monomial(svm.support[i].data, monomial);
+    const svm_float_t w = svm.lambda[i] * svm.support[i].classification;
+    for (std::size_t k = 0; k < coefficient.size(); k++)
+      coefficient[k] += w * monomial[k];
+  }
+  for (std::size_t k = 0; k < coefficient.size(); k++)
+    coefficient[k] *= multinomial[k] * factor[degree[k]];
+}
+
+template <std::size_t Dimension, std::floating_point svm_float_t>
+void PolynomialSVM<Dimension, svm_float_t>::Monomial(
+    const data_t& data, std::vector<svm_float_t>& monomial) const {
+  monomial.resize(parent.size());
+  monomial[0] = 1;
+  for (std::size_t k = 1; k < parent.size(); k++)
+    monomial[k] = monomial[parent[k]] * data[variable[k]];
+}
+
+template <std::size_t Dimension, std::floating_point svm_float_t>
+svm_float_t PolynomialSVM<Dimension, svm_float_t>::Decision(
+    const data_t& data) const {
+  thread_local std::vector<svm_float_t> monomial;
+  Monomial(data, monomial);
+  return std::transform_reduce(coefficient.begin(), coefficient.end(),
+                               monomial.begin(), bias);
+}
+
+template <std::size_t Dimension, std::floating_point svm_float_t>
+ClassificationType PolynomialSVM<Dimension, svm_float_t>::operator()(
+    const data_t& data) const {
+  return sgn(Decision(data));
+}
+
+}  // namespace SVM
+
+#endif
\ No newline at end of file
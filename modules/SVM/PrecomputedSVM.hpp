@@ -0,0 +1,62 @@
+#ifndef __SVM_PRECOMPUTED_SVM_HPP__
+#define __SVM_PRECOMPUTED_SVM_HPP__
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "DataSet/MappedGramMatrix.hpp"
+#include "common/common.hpp"
+
+namespace SVM {
+
+// 以预计算核矩阵训练得到的SVM，只记录支持向量在训练集中的下标
+// 预测时读取测试集 * 训练集核矩阵的对应行，从不计算核函数
+template <std::floating_point svm_float_t = double>
+struct PrecomputedSVM {
+  // 训练集大小，即预测用核矩阵的列数
+  std::size_t train_size = 0;
+  std::vector<std::size_t> support;
+  // lambda_i * y_i
+  std::vector<svm_float_t> coefficient;
+  svm_float_t bias = 0;
+
+  // 第row个测试样本的决策函数值，符号即为分类
+  template <std::floating_point gram_float_t>
+  svm_float_t Decision(const MappedGramMatrix<gram_float_t>&,
+                       std::size_t row) const;
+  template <std::floating_point gram_float_t>
+  ClassificationType operator()(const MappedGramMatrix<gram_float_t>& gram,
+                                std::size_t row) const {
+    return sgn(Decision(gram, row));
+  }
+};
+
+}  // namespace SVM
+
+//////////implementation//////////
+
+namespace SVM {
+
+template <std::floating_point svm_float_t>
+template <std::floating_point gram_float_t>
+svm_float_t PrecomputedSVM<svm_float_t>::Decision(
+    const MappedGramMatrix<gram_float_t>& gram, std::size_t row) const {
+  if (gram.Cols() != train_size)
+    throw std::runtime_error("Fail to predict: gram matrix has " +
+                             std::to_string(gram.Cols()) + " columns, " +
+                             std::to_string(train_size) + " expected.");
+  if (row >= gram.Rows())
+    throw std::runtime_error("Fail to predict: gram matrix has " +
+                             std::to_string(gram.Rows()) + " rows, row " +
+                             std::to_string(row) + " requested.");
+  svm_float_t result = bias;
+  for (std::size_t k = 0; k < support.size(); k++)
+    result += coefficient[k] * gram(row, support[k]);
+  return result;
+}
+
+}  // namespace SVM
+
+#endif
\ No newline at end of file
@@ -0,0 +1,183 @@
+#ifndef __SVM_PRUNED_RBF_SVM_HPP__
+#define __SVM_PRUNED_RBF_SVM_HPP__
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include "Kernel/RBFKernel.hpp"
+#include "SVM/SVM.hpp"
+#include "common/common.hpp"
+
+namespace SVM {
+
+// 以KD树索引支持向量的RBF核SVM，适用于低维数据
+// 对于查询x与节点包围盒的最小距离d，节点内支持向量的贡献不超过
+// sum|lambda * y| * exp(-d^2 / Width)；该上界不超过剩余误差预算时整块跳过，
+// 因此被跳过部分的总贡献不超过Tolerance
+template <std::size_t Dimension, std::floating_point svm_float_t = double>
+class PrunedRBFSVM {
+  using data_t = FixedVector<Dimension, svm_float_t>;
+
+  struct Node {
+    data_t lower, upper;
+    // 节点包含support[first, last)
+    std::size_t first, last;
+    // 子节点下标，叶子为0
+    std::size_t left = 0, right = 0;
+    svm_float_t weight;
+  };
+  static constexpr std::size_t LeafSize = 16;
+
+  RBFKernel<Dimension, svm_float_t> kernel;
+  svm_float_t Tolerance;
+  std::vector<data_t> support;
+  std::vector<svm_float_t> coefficient;
+  std::vector<Node> node;
+  svm_float_t bias;
+
+  std::size_t Build(std::size_t, std::size_t);
+
+ public:
+  PrunedRBFSVM(const CompactSVM<Dimension, svm_float_t>&,
+               const RBFKernel<Dimension, svm_float_t>&,
+               svm_float_t Tolerance = 1e-6);
+
+  // skipped返回被跳过部分贡献之和的上界
+  svm_float_t Decision(const data_t&, svm_float_t& skipped) const;
+  svm_float_t Decision(const data_t& data) const {
+    svm_float_t skipped;
+    return Decision(data, skipped);
+  }
+  ClassificationType operator()(const data_t&) const;
+};
+
+}  // namespace SVM
+
+//////////implementation//////////
+
+namespace SVM {
+
+template <std::size_t Dimension, std::floating_point svm_float_t>
+PrunedRBFSVM<Dimension, svm_float_t>::PrunedRBFSVM(
+    const CompactSVM<Dimension, svm_float_t>& svm,
+    const RBFKernel<Dimension, svm_float_t>& _kernel,
+    svm_float_t _Tolerance)
+    : kernel(_kernel), Tolerance(_Tolerance), bias(svm.bias) {
+  for (std::size_t i = 0; i < svm.support.size(); i++) {
+    support.push_back(svm.support[i].data);
+    coefficient.push_back(svm.lambda[i] * svm.support[i].classification);
+  }
+  if (!support.empty()) Build(0, support.size());
+}
+
+// 沿包围盒最宽的维度按中位数划分，返回节点下标
+template <std::size_t Dimension, std::floating_point svm_float_t>
+std::size_t PrunedRBFSVM<Dimension, svm_float_t>::Build(std::size_t first,
+                                                        std::size_t last) {
+  const std::size_t index = node.size();
+  node.push_back({support[first], support[first], first, last});
+  Node& current = node.back();
+  current.weight = 0;
+  for (std::size_t i = first; i < last; i++) {
+    current.weight += std::abs(coefficient[i]);
+    for (std::size_t d = 0; d < Dimension; d++) {
+      current.lower[d] = std::min(current.lower[d], support[i][d]);
+      current.upper[d] = std::max(current.upper[d], support[i][d]);
+    }
+  }
+  if (last - first <= LeafSize) return index;
+
+  std::size_t axis = 0;
+  for (std::size_t d = 1; d < Dimension; d++)
+    if (current.upper[d] - current.lower[d] >
+        current.upper[axis] - current.lower[axis])
+      axis = d;
+  // 支持向量与系数一同重排
+  std::vector<std::size_t> order(last - first);
+  std::iota(order.begin(), order.end(), first);
+  const std::size_t middle = (last - first) / 2;
+  std::ranges::nth_element(order, order.begin() + middle,
+                           [&](std::size_t a, std::size_t b) {
+                             return support[a][axis] < support[b][axis];
+                           });
+  std::vector<data_t> sorted_support;
+  std::vector<svm_float_t> sorted_coefficient;
+  for (std::size_t i : order) {
+    sorted_support.push_back(support[i]);
+    sorted_coefficient.push_back(coefficient[i]);
+  }
+  std::ranges::copy(sorted_support, support.begin() + first);
+  std::ranges::copy(sorted_coefficient, coefficient.begin() + first);
+
+  const std::size_t left = Build(first, first + middle);
+  const std::size_t right = Build(first + middle, last);
+  // 递归中node可能重新分配，不能继续使用current
+  node[index].left = left;
+  node[index].right = right;
+  return index;
+}
+
+template <std::size_t Dimension, std::floating_point svm_float_t>
+svm_float_t PrunedRBFSVM<Dimension, svm_float_t>::Decision(
+    const data_t& data, svm_float_t& skipped) const {
+  svm_float_t result = bias, budget = Tolerance;
+  skipped = 0;
+  if (node.empty()) return result;
+
+  auto min_distance = [&](const Node& n) {
+    svm_float_t distance = 0;
+    for (std::size_t d = 0; d < Dimension; d++) {
+      const svm_float_t gap = std::max(
+          {n.lower[d] - data[d], data[d] - n.upper[d], svm_float_t(0)});
+      distance += gap * gap;
+    }
+    return distance;
+  };
+
+  // 按中位数划分的树深度不超过log2(n)，栈中至多同时存在深度 + 1个节点
+  // 与节点一同保存其最小距离，避免重复计算
+  std::array<std::pair<std::size_t, svm_float_t>, 128> stack;
+  stack[0] = {0, min_distance(node[0])};
+  std::size_t top = 1;
+  while (top) {
+    const auto [index, distance] = stack[--top];
+    const Node& n = node[index];
+    const svm_float_t bound = n.weight * std::exp(-distance / kernel.Width);
+    if (bound <= budget) {
+      budget -= bound;
+      skipped += bound;
+      continue;
+    }
+    if (n.left == 0) {
+      svm_float_t row[LeafSize];
+      kernel.Row(data, support.begin() + n.first, support.begin() + n.last,
+                 row);
+      for (std::size_t i = n.first; i < n.last; i++)
+        result += coefficient[i] * row[i - n.first];
+      continue;
+    }
+    // 先访问较近的子节点，使较远的子节点更可能被整块跳过
+    std::pair<std::size_t, svm_float_t> near{n.left,
+                                             min_distance(node[n.left])},
+        far{n.right, min_distance(node[n.right])};
+    if (far.second < near.second) std::swap(near, far);
+    stack[top++] = far;
+    stack[top++] = near;
+  }
+  return result;
+}
+
+template <std::size_t Dimension, std::floating_point svm_float_t>
+ClassificationType PrunedRBFSVM<Dimension, svm_float_t>::operator()(
+    const data_t& data) const {
+  return sgn(Decision(data));
+}
+
+}  // namespace SVM
+
+#endif
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include <cstddef>
 #include <functional>
 #include <numeric>
+#include <vector>
 
 #include "Sample/Sample.hpp"
 #include "SegmentPlane/SegmentPlane.hpp"
@@ -15,6 +16,8 @@ namespace SVM {
 
 template <std::size_t Dimension, std::floating_point svm_float_t = double>
 struct LinearSVM;
+template <std::size_t Dimension, std::floating_point svm_float_t = double>
+struct CompactSVM;
 template <std::size_t DataSetSize, std::size_t Dimension,
           std::floating_point svm_float_t = double>
 class SVM;
@@ -35,6 +38,14 @@ void LinearSMO(
     const DataCallback<std::size_t>& = [](std::size_t) {},
     const DataCallback<decltype(svm_float_t())>& = [](svm_float_t) {});
 
+template <std::size_t DataSetSize, std::size_t Dimension,
+          std::floating_point svm_float_t = double>
+void ParallelDCD(
+    SVM<DataSetSize, Dimension, svm_float_t>&, svm_float_t, std::size_t,
+    svm_float_t, std::size_t = 0, std::size_t = 0,
+    const DataCallback<std::size_t>& = [](std::size_t) {},
+    const DataCallback<decltype(svm_float_t())>& = [](svm_float_t) {});
+
 //////////end//////////
 
 template <std::size_t DataSetSize, std::size_t Dimension,
@@ -43,7 +54,7 @@ class SVM {
   using sample_t = Sample<Dimension, svm_float_t>;
   using data_t = decltype(sample_t().data);
   std::array<sample_t, DataSetSize> sample;
-  svm_float_t bias;
+  svm_float_t bias = 0;
 
   using kernel_function_t =
       std::function<svm_float_t(const data_t&, const data_t&)>;
@@ -51,6 +62,7 @@ class SVM {
 
  public:
   friend struct LinearSVM<Dimension, svm_float_t>;
+  friend struct CompactSVM<Dimension, svm_float_t>;
   friend void SMO<>(SVM<DataSetSize, Dimension, svm_float_t>&, svm_float_t,
                     std::size_t, svm_float_t, std::size_t,
                     const DataCallback<std::size_t>&,
@@ -59,14 +71,24 @@ class SVM {
                           svm_float_t, std::size_t, svm_float_t, std::size_t,
                           const DataCallback<std::size_t>&,
                           const DataCallback<decltype(svm_float_t())>&);
+  friend void ParallelDCD<>(SVM<DataSetSize, Dimension, svm_float_t>&,
+                            svm_float_t, std::size_t, svm_float_t, std::size_t,
+                            std::size_t, const DataCallback<std::size_t>&,
+                            const DataCallback<decltype(svm_float_t())>&);
 
  public:
   FixedVector<DataSetSize, svm_float_t> lambda;
+  // 样本权重，训练时lambda_i的上界为Tolerance * weight[i]，默认均为1
+  FixedVector<DataSetSize, svm_float_t> weight;
 
   template <std::forward_iterator forwardIt>
   SVM(forwardIt, const kernel_function_t&);
+  // 从weightIt依次读入各样本的权重
+  template <std::forward_iterator forwardIt, std::input_iterator weightIt>
+  SVM(forwardIt, weightIt, const kernel_function_t&);
   SVM() = delete;
-  ClassificationType operator()(const FixedVector<Dimension, svm_float_t>&);
+  ClassificationType operator()(
+      const FixedVector<Dimension, svm_float_t>&) const;
 };
 
 template <std::size_t Dimension, std::floating_point svm_float_t>
@@ -74,10 +96,37 @@ struct LinearSVM {
   SegmentPlane<Dimension, svm_float_t> segmentation;
 
   LinearSVM() = delete;
+  explicit LinearSVM(const SegmentPlane<Dimension, svm_float_t>& _segmentation)
+      : segmentation(_segmentation) {}
   template <std::size_t DataSetSize>
   LinearSVM(const SVM<DataSetSize, Dimension, svm_float_t>&);
 
-  ClassificationType operator()(const FixedVector<Dimension, svm_float_t>&);
+  // 决策函数值，符号即为分类
+  svm_float_t Decision(const FixedVector<Dimension, svm_float_t>&) const;
+  ClassificationType operator()(
+      const FixedVector<Dimension, svm_float_t>&) const;
+};
+
+// 仅保留支持向量的SVM，支持向量数量在运行时决定
+template <std::size_t Dimension, std::floating_point svm_float_t>
+struct CompactSVM {
+  using sample_t = Sample<Dimension, svm_float_t>;
+  using data_t = decltype(sample_t().data);
+  using kernel_function_t =
+      std::function<svm_float_t(const data_t&, const data_t&)>;
+
+  std::vector<sample_t> support;
+  std::vector<svm_float_t> lambda;
+  svm_float_t bias = 0;
+  kernel_function_t kernel;
+
+  explicit CompactSVM(const kernel_function_t&);
+  template <std::size_t DataSetSize>
+  CompactSVM(const SVM<DataSetSize, Dimension, svm_float_t>&);
+
+  // 决策函数值，符号即为分类
+  svm_float_t Decision(const data_t&) const;
+  ClassificationType operator()(const data_t&) const;
 };
 
 }  // namespace SVM
@@ -92,12 +141,27 @@ template <std::forward_iterator forwardIt>
 SVM<DataSetSize, Dimension, svm_float_t>::SVM(forwardIt first,
                                               const kernel_function_t& _kernel)
     : kernel(_kernel) {
-  for (int i = 0; i < DataSetSize; i++) sample[i] = *first++;
+  for (std::size_t i = 0; i < DataSetSize; i++) {
+    sample[i] = *first++;
+    weight[i] = 1;
+  }
+}
+template <std::size_t DataSetSize, std::size_t Dimension,
+          std::floating_point svm_float_t>
+template <std::forward_iterator forwardIt, std::input_iterator weightIt>
+SVM<DataSetSize, Dimension, svm_float_t>::SVM(forwardIt first,
+                                              weightIt weight_first,
+                                              const kernel_function_t& _kernel)
+    : kernel(_kernel) {
+  for (std::size_t i = 0; i < DataSetSize; i++) {
+    sample[i] = *first++;
+    weight[i] = *weight_first++;
+  }
 }
 template <std::size_t DataSetSize, std::size_t Dimension,
           std::floating_point svm_float_t>
 ClassificationType SVM<DataSetSize, Dimension, svm_float_t>::operator()(
-    const FixedVector<Dimension, svm_float_t>& data) {
+    const FixedVector<Dimension, svm_float_t>& data) const {
   svm_float_t classfication = std::transform_reduce(
       sample.begin(), sample.end(), lambda.begin(), bias, std::plus<>{},
       [&](const sample_t& xi, const svm_float_t& l) {
@@ -111,22 +175,55 @@ template <std::size_t Dimension, std::floating_point svm_float_t>
 template <std::size_t DataSetSize>
 LinearSVM<Dimension, svm_float_t>::LinearSVM(
     const SVM<DataSetSize, Dimension, svm_float_t>& svm) {
-  using sample_t = Sample<Dimension, svm_float_t>;
-  segmentation.weight = std::transform_reduce(
-      svm.sample.begin(), svm.sample.end(), svm.lambda.begin(),
-      decltype(segmentation.weight)(), std::plus<>{},
-      [&](const sample_t& xi, const svm_float_t& l) {
-        return xi.data * l * xi.classification;
-      });
+  segmentation.weight = {};
+  for (std::size_t i = 0; i < DataSetSize; i++)
+    segmentation.weight.axpy(svm.lambda[i] * svm.sample[i].classification,
+                             svm.sample[i].data);
   segmentation.bias = svm.bias;
 }
 
+template <std::size_t Dimension, std::floating_point svm_float_t>
+svm_float_t LinearSVM<Dimension, svm_float_t>::Decision(
+    const FixedVector<Dimension, svm_float_t>& data) const {
+  return segmentation.weight.dot(data) + segmentation.bias;
+}
+
 template <std::size_t Dimension, std::floating_point svm_float_t>
 ClassificationType LinearSVM<Dimension, svm_float_t>::operator()(
-    const FixedVector<Dimension, svm_float_t>& data) {
-  svm_float_t&& classfication =
-      segmentation.weight.dot(data) + segmentation.bias;
-  return sgn(classfication);
+    const FixedVector<Dimension, svm_float_t>& data) const {
+  return sgn(Decision(data));
+}
+
+template <std::size_t Dimension, std::floating_point svm_float_t>
+CompactSVM<Dimension, svm_float_t>::CompactSVM(const kernel_function_t& _kernel)
+    : kernel(_kernel) {}
+
+template <std::size_t Dimension, std::floating_point svm_float_t>
+template <std::size_t DataSetSize>
+CompactSVM<Dimension, svm_float_t>::CompactSVM(
+    const SVM<DataSetSize, Dimension, svm_float_t>& svm)
+    : bias(svm.bias), kernel(svm.kernel) {
+  for (std::size_t i = 0; i < DataSetSize; i++) {
+    if (sgn(svm.lambda[i]) == 0) continue;
+    support.push_back(svm.sample[i]);
+    lambda.push_back(svm.lambda[i]);
+  }
+}
+
+template <std::size_t Dimension, std::floating_point svm_float_t>
+svm_float_t CompactSVM<Dimension, svm_float_t>::Decision(
+    const data_t& data) const {
+  return std::transform_reduce(
+      support.begin(), support.end(), lambda.begin(), bias, std::plus<>{},
+      [&](const sample_t& xi, const svm_float_t& l) {
+        return xi.classification * l * kernel(xi.data, data);
+      });
+}
+
+template <std::size_t Dimension, std::floating_point svm_float_t>
+ClassificationType CompactSVM<Dimension, svm_float_t>::operator()(
+    const data_t& data) const {
+  return sgn(Decision(data));
 }
 
 }  // namespace SVM
@@ -0,0 +1,134 @@
+#ifndef __SVM_SVM_BUNDLE_HPP__
+#define __SVM_SVM_BUNDLE_HPP__
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <map>
+#include <vector>
+
+#include "SVM/SVM.hpp"
+#include "common/Parallel.hpp"
+#include "common/common.hpp"
+
+namespace SVM {
+
+// 共用同一核函数的多个模型，一次求出全部决策函数值
+// 各模型的支持向量去重后合并为并集，每个查询对并集只计算一次核函数行，
+// 再与(并集大小 * 模型数)的系数矩阵相乘
+template <std::size_t Dimension, class Kernel,
+          std::floating_point svm_float_t = double>
+class SVMBundle {
+  using data_t = FixedVector<Dimension, svm_float_t>;
+
+  Kernel kernel;
+  std::size_t models = 0;
+  std::vector<data_t> support;
+  // 第i个支持向量在第m个模型中的lambda * y位于coefficient[i * models + m]
+  std::vector<svm_float_t> coefficient;
+  std::vector<svm_float_t> bias;
+
+ public:
+  // [first, last)为CompactSVM序列，模型自身携带的核函数被忽略
+  template <std::forward_iterator forwardIt>
+  SVMBundle(forwardIt first, forwardIt last, const Kernel&);
+
+  std::size_t Models() const { return models; }
+  // 支持向量并集的大小
+  std::size_t Size() const { return support.size(); }
+
+  // 将各模型的决策函数值依次写入output
+  template <std::output_iterator<svm_float_t> outputIt>
+  void Decision(const data_t&, outputIt output) const;
+  std::vector<svm_float_t> Decision(const data_t&) const;
+  // 分块并行求[first, last)的决策函数值，第i个样本的结果位于
+  // output[i * Models(), (i + 1) * Models())
+  template <std::random_access_iterator randomIt,
+            std::random_access_iterator outputIt>
+  void DecisionBatch(randomIt first, randomIt last, outputIt output,
+                     std::size_t Threads = DefaultThreads()) const;
+};
+
+}  // namespace SVM
+
+//////////implementation//////////
+
+namespace SVM {
+
+template <std::size_t Dimension, class Kernel, std::floating_point svm_float_t>
+template <std::forward_iterator forwardIt>
+SVMBundle<Dimension, Kernel, svm_float_t>::SVMBundle(forwardIt first,
+                                                     forwardIt last,
+                                                     const Kernel& _kernel)
+    : kernel(_kernel), models(std::distance(first, last)) {
+  auto less = [](const data_t& a, const data_t& b) {
+    return std::ranges::lexicographical_compare(a, b);
+  };
+  std::map<data_t, std::size_t, decltype(less)> position(less);
+  for (std::size_t m = 0; first != last; ++first, m++) {
+    const CompactSVM<Dimension, svm_float_t>& svm = *first;
+    bias.push_back(svm.bias);
+    for (std::size_t i = 0; i < svm.support.size(); i++) {
+      const auto& [y, x] = svm.support[i];
+      auto [it, inserted] = position.try_emplace(x, support.size());
+      if (inserted) {
+        support.push_back(x);
+        coefficient.resize(coefficient.size() + models, 0);
+      }
+      coefficient[it->second * models + m] += svm.lambda[i] * y;
+    }
+  }
+}
+
+template <std::size_t Dimension, class Kernel, std::floating_point svm_float_t>
+template <std::output_iterator<svm_float_t> outputIt>
+void SVMBundle<Dimension, Kernel, svm_float_t>::Decision(
+    const data_t& data, outputIt output) const {
+  // 各线程复用同一缓冲，避免每次查询分配内存
+  thread_local std::vector<svm_float_t> result, row;
+  result.assign(bias.begin(), bias.end());
+  row.resize(support.size());
+  // 内置核整行批量计算
+  if constexpr (requires {
+                  kernel.Row(data, support.begin(), support.end(), row.data());
+                })
+    kernel.Row(data, support.begin(), support.end(), row.data());
+  else
+    for (std::size_t i = 0; i < support.size(); i++)
+      row[i] = kernel(support[i], data);
+  for (std::size_t i = 0; i < support.size(); i++) {
+    const svm_float_t* c = coefficient.data() + i * models;
+    for (std::size_t m = 0; m < models; m++) result[m] += c[m] * row[i];
+  }
+  std::ranges::copy(result, output);
+}
+
+template <std::size_t Dimension, class Kernel, std::floating_point svm_float_t>
+std::vector<svm_float_t> SVMBundle<Dimension, Kernel, svm_float_t>::Decision(
+    const data_t& data) const {
+  std::vector<svm_float_t> result;
+  result.reserve(models);
+  Decision(data, std::back_inserter(result));
+  return result;
+}
+
+template <std::size_t Dimension, class Kernel, std::floating_point svm_float_t>
+template <std::random_access_iterator randomIt,
+          std::random_access_iterator outputIt>
+void SVMBundle<Dimension, Kernel, svm_float_t>::DecisionBatch(
+    randomIt first, randomIt last, outputIt output,
+    std::size_t Threads) const {
+  const std::size_t n = last - first, Tile = 1 << 8;
+  ParallelFor(
+      (n + Tile - 1) / Tile,
+      [&](std::size_t tile) {
+        const std::size_t end = std::min(n, (tile + 1) * Tile);
+        for (std::size_t i = tile * Tile; i < end; i++)
+          Decision(first[i], output + i * models);
+      },
+      Threads);
+}
+
+}  // namespace SVM
+
+#endif
\ No newline at end of file
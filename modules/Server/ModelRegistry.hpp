@@ -0,0 +1,128 @@
+#ifndef __SVM_MODEL_REGISTRY_HPP__
+#define __SVM_MODEL_REGISTRY_HPP__
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "Kernel/BuiltinKernel.hpp"
+#include "SVM/ModelFile.hpp"
+#include "SVM/SVM.hpp"
+#include "SVM/SVMBundle.hpp"
+#include "common/Parallel.hpp"
+#include "common/common.hpp"
+
+namespace SVM {
+
+// 常驻内存的模型及其批量求值函数，发布后不再修改
+template <std::size_t Dimension, std::floating_point svm_float_t = double>
+struct ServedModel {
+  using data_t = FixedVector<Dimension, svm_float_t>;
+
+  std::string name;
+  uint64_t version;
+  CompactSVM<Dimension, svm_float_t> svm;
+  // 求data[0, n)的决策函数值写入output
+  std::function<void(const data_t* data, std::size_t n, svm_float_t* output)>
+      Decision;
+};
+
+// 按名称管理常驻模型，发布新版本时原子替换
+// 查询得到的是某一版本的共享指针，替换后正在处理的请求仍使用旧版本直至完成
+template <std::size_t Dimension, std::floating_point svm_float_t = double>
+class ModelRegistry {
+ public:
+  using model_t = ServedModel<Dimension, svm_float_t>;
+
+ private:
+  mutable std::shared_mutex mutex;
+  std::map<std::string, std::shared_ptr<const model_t>> models;
+  uint64_t version = 0;
+  std::size_t Threads;
+
+ public:
+  // Threads为单个批次求值时的线程数
+  explicit ModelRegistry(std::size_t Threads = DefaultThreads())
+      : Threads(Threads) {}
+
+  // 发布模型并返回版本号，版本号在整个注册表内单调递增
+  uint64_t Publish(const std::string& name,
+                   CompactSVM<Dimension, svm_float_t> svm);
+  // 读取SaveModel保存的模型文件并发布
+  uint64_t Load(const std::string& name, const std::filesystem::path&);
+  // 不存在时返回空指针
+  std::shared_ptr<const model_t> Find(const std::string& name) const;
+  std::vector<std::string> Names() const;
+};
+
+}  // namespace SVM
+
+//////////implementation//////////
+
+namespace SVM {
+
+template <std::size_t Dimension, std::floating_point svm_float_t>
+uint64_t ModelRegistry<Dimension, svm_float_t>::Publish(
+    const std::string& name, CompactSVM<Dimension, svm_float_t> svm) {
+  auto model = std::make_shared<model_t>(model_t{name, 0, std::move(svm), {}});
+  // 内置核以SVMBundle整行批量求核函数值，其余核逐个调用
+  const bool builtin = VisitBuiltinKernel<Dimension, svm_float_t>(
+      model->svm.kernel, [&]<class Kernel>(const Kernel& kernel) {
+        auto bundle =
+            std::make_shared<SVMBundle<Dimension, Kernel, svm_float_t>>(
+                &model->svm, &model->svm + 1, kernel);
+        model->Decision = [bundle, Threads = Threads](
+                              const typename model_t::data_t* data,
+                              std::size_t n, svm_float_t* output) {
+          bundle->DecisionBatch(data, data + n, output, Threads);
+        };
+      });
+  if (!builtin)
+    model->Decision = [&svm = model->svm](const typename model_t::data_t* data,
+                                          std::size_t n, svm_float_t* output) {
+      for (std::size_t i = 0; i < n; i++) output[i] = svm.Decision(data[i]);
+    };
+
+  std::unique_lock lock(mutex);
+  model->version = ++version;
+  models[name] = std::move(model);
+  return version;
+}
+
+template <std::size_t Dimension, std::floating_point svm_float_t>
+uint64_t ModelRegistry<Dimension, svm_float_t>::Load(
+    const std::string& name, const std::filesystem::path& path) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file) throw std::runtime_error("Fail to open " + path.string() + ".");
+  // 在锁外读取与构建，替换时只短暂持有写锁
+  return Publish(name, LoadModel<Dimension, svm_float_t>(file));
+}
+
+template <std::size_t Dimension, std::floating_point svm_float_t>
+std::shared_ptr<const ServedModel<Dimension, svm_float_t>>
+ModelRegistry<Dimension, svm_float_t>::Find(const std::string& name) const {
+  std::shared_lock lock(mutex);
+  auto it = models.find(name);
+  return it == models.end() ? nullptr : it->second;
+}
+
+template <std::size_t Dimension, std::floating_point svm_float_t>
+std::vector<std::string> ModelRegistry<Dimension, svm_float_t>::Names() const {
+  std::shared_lock lock(mutex);
+  std::vector<std::string> names;
+  for (const auto& [name, model] : models) names.push_back(name);
+  return names;
+}
+
+}  // namespace SVM
+
+#endif
\ No newline at end of file
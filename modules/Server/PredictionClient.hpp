@@ -0,0 +1,158 @@
+#ifndef __SVM_PREDICTION_CLIENT_HPP__
+#define __SVM_PREDICTION_CLIENT_HPP__
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "Server/Protocol.hpp"
+#include "common/common.hpp"
+
+namespace SVM {
+
+// PredictionServer的客户端，每个对象持有一个连接，不可跨线程同时使用
+// 服务端返回错误时抛出std::runtime_error
+template <std::size_t Dimension, std::floating_point svm_float_t = double>
+class PredictionClient {
+  int fd = -1;
+  std::vector<svm_float_t> buffer;
+
+  RequestHeader Header(RequestType, const std::string& model, uint64_t) const;
+  // 发送请求头与负载，服务端中途关闭连接时抛出其已回复的错误信息
+  void Send(const RequestHeader&, const void* payload, std::size_t size);
+  // 读取响应头，出错时读出错误信息并抛出
+  ResponseHeader Receive();
+
+ public:
+  explicit PredictionClient(const std::string& path);
+  ~PredictionClient();
+  PredictionClient(const PredictionClient&) = delete;
+
+  // 求[first, last)在model上的决策函数值并依次写入output
+  // 超过MaxRequestRows行时分段请求
+  template <std::random_access_iterator randomIt,
+            std::output_iterator<svm_float_t> outputIt>
+  void Score(const std::string& model, randomIt first, randomIt last,
+             outputIt output);
+  // 令服务端读取模型文件并替换model，返回新版本号
+  uint64_t Load(const std::string& model, const std::string& file);
+  LatencyReport Stats();
+};
+
+}  // namespace SVM
+
+//////////implementation//////////
+
+namespace SVM {
+
+template <std::size_t Dimension, std::floating_point svm_float_t>
+PredictionClient<Dimension, svm_float_t>::PredictionClient(
+    const std::string& path) {
+  const sockaddr_un address = SocketAddress(path);
+  fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd < 0) throw std::runtime_error("Fail to create socket.");
+  if (::connect(fd, reinterpret_cast<const sockaddr*>(&address),
+                sizeof(address)) != 0) {
+    ::close(fd);
+    throw std::runtime_error("Fail to connect to " + path + ".");
+  }
+}
+
+template <std::size_t Dimension, std::floating_point svm_float_t>
+PredictionClient<Dimension, svm_float_t>::~PredictionClient() {
+  ::close(fd);
+}
+
+template <std::size_t Dimension, std::floating_point svm_float_t>
+RequestHeader PredictionClient<Dimension, svm_float_t>::Header(
+    RequestType type, const std::string& model, uint64_t count) const {
+  if (model.size() > ModelNameSize)
+    throw std::runtime_error("Model name is too long.");
+  RequestHeader header;
+  header.type = type;
+  header.dimension = Dimension;
+  header.float_size = sizeof(svm_float_t);
+  header.count = count;
+  std::ranges::copy(model, header.model);
+  return header;
+}
+
+template <std::size_t Dimension, std::floating_point svm_float_t>
+void PredictionClient<Dimension, svm_float_t>::Send(
+    const RequestHeader& header, const void* payload, std::size_t size) {
+  if (WriteFull(fd, &header, sizeof(header)) &&
+      WriteFull(fd, payload, size))
+    return;
+  // 服务端拒绝请求时先回复错误再关闭连接，错误仍可读出
+  Receive();
+  throw std::runtime_error("Fail to send request.");
+}
+
+template <std::size_t Dimension, std::floating_point svm_float_t>
+ResponseHeader PredictionClient<Dimension, svm_float_t>::Receive() {
+  ResponseHeader header;
+  if (!ReadFull(fd, &header, sizeof(header)))
+    throw std::runtime_error("Prediction server closed the connection.");
+  if (header.status != ResponseStatus::Ok) {
+    std::string message(header.count, '\0');
+    ReadFull(fd, message.data(), message.size());
+    throw std::runtime_error(message);
+  }
+  return header;
+}
+
+template <std::size_t Dimension, std::floating_point svm_float_t>
+template <std::random_access_iterator randomIt,
+          std::output_iterator<svm_float_t> outputIt>
+void PredictionClient<Dimension, svm_float_t>::Score(const std::string& model,
+                                                     randomIt first,
+                                                     randomIt last,
+                                                     outputIt output) {
+  const std::size_t N = last - first;
+  for (std::size_t begin = 0; begin < N; begin += MaxRequestRows) {
+    const std::size_t n = std::min<std::size_t>(MaxRequestRows, N - begin);
+    buffer.resize(n * Dimension);
+    for (std::size_t i = 0; i < n; i++)
+      for (std::size_t d = 0; d < Dimension; d++)
+        buffer[i * Dimension + d] = first[begin + i][d];
+    Send(Header(RequestType::Score, model, n), buffer.data(),
+         buffer.size() * sizeof(svm_float_t));
+
+    if (Receive().count != n)
+      throw std::runtime_error("Mismatched score response.");
+    buffer.resize(n);
+    if (!ReadFull(fd, buffer.data(), n * sizeof(svm_float_t)))
+      throw std::runtime_error("Fail to read score response.");
+    output = std::ranges::copy(buffer, output).out;
+  }
+}
+
+template <std::size_t Dimension, std::floating_point svm_float_t>
+uint64_t PredictionClient<Dimension, svm_float_t>::Load(
+    const std::string& model, const std::string& file) {
+  Send(Header(RequestType::Load, model, file.size()), file.data(),
+       file.size());
+  return Receive().count;
+}
+
+template <std::size_t Dimension, std::floating_point svm_float_t>
+LatencyReport PredictionClient<Dimension, svm_float_t>::Stats() {
+  Send(Header(RequestType::Stats, "", 0), nullptr, 0);
+  Receive();
+  LatencyReport report;
+  if (!ReadFull(fd, &report, sizeof(report)))
+    throw std::runtime_error("Fail to read stats response.");
+  return report;
+}
+
+}  // namespace SVM
+
+#endif
\ No newline at end of file
@@ -0,0 +1,355 @@
+#ifndef __SVM_PREDICTION_SERVER_HPP__
+#define __SVM_PREDICTION_SERVER_HPP__
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <future>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "Server/ModelRegistry.hpp"
+#include "Server/Protocol.hpp"
+#include "common/common.hpp"
+
+namespace SVM {
+
+// 计算延迟分位数时保留的最近请求数
+const std::size_t LatencyWindow = 1 << 16;
+
+// 常驻的本地预测服务，通过Unix域套接字接收请求
+// 每个连接由独立线程读取请求，打分请求交给合并线程：
+// 收到首个请求后至多再等待BatchWait，将期间到达的同一模型的请求拼接为一批，
+// 一次求出全部决策函数值后分发给各连接；批次行数达到MaxBatch或
+// 所有连接均有请求在等待时立即求值
+template <std::size_t Dimension, std::floating_point svm_float_t = double>
+class PredictionServer {
+  using data_t = FixedVector<Dimension, svm_float_t>;
+  using clock = std::chrono::steady_clock;
+
+  struct Pending {
+    std::string model;
+    std::vector<data_t> data;
+    std::vector<svm_float_t> result;
+    std::string error;
+    std::promise<void> done;
+  };
+
+  ModelRegistry<Dimension, svm_float_t>& registry;
+  const std::string path;
+  const std::size_t MaxBatch;
+  const std::chrono::microseconds BatchWait;
+  int listener = -1;
+  std::atomic<bool> running = false;
+  // Run开始监听前调用Stop时置位，Run随即返回
+  bool stop_requested = false;
+
+  std::mutex queue_mutex;
+  std::condition_variable queue_cv;
+  std::deque<Pending*> queue;
+  std::size_t queue_rows = 0;
+  // 所有连接退出后置位，合并线程处理完剩余请求后结束
+  bool drained = false;
+
+  mutable std::mutex latency_mutex;
+  std::vector<double> latency;
+  LatencyReport counter;
+
+  std::mutex connection_mutex;
+  std::condition_variable connection_cv;
+  std::vector<int> connections;
+  // 连接数，每个连接同时至多有一个请求在等待
+  std::atomic<std::size_t> connection_count = 0;
+
+  void Batch();
+  void Serve(int);
+  bool Respond(int, ResponseStatus, uint64_t, const void*, std::size_t);
+
+ public:
+  PredictionServer(ModelRegistry<Dimension, svm_float_t>&,
+                   const std::string& path, std::size_t MaxBatch = 4096,
+                   std::chrono::microseconds BatchWait =
+                       std::chrono::microseconds(100));
+  ~PredictionServer() { Stop(); }
+  PredictionServer(const PredictionServer&) = delete;
+
+  // 监听path并阻塞处理请求，Stop后等待所有连接结束再返回
+  void Run();
+  // 可在任意线程调用，在Run之前调用时下一次Run立即返回
+  void Stop();
+  // 最近LatencyWindow个请求的延迟分位数
+  LatencyReport Latency() const;
+};
+
+}  // namespace SVM
+
+//////////implementation//////////
+
+namespace SVM {
+
+template <std::size_t Dimension, std::floating_point svm_float_t>
+PredictionServer<Dimension, svm_float_t>::PredictionServer(
+    ModelRegistry<Dimension, svm_float_t>& _registry, const std::string& _path,
+    std::size_t _MaxBatch, std::chrono::microseconds _BatchWait)
+    : registry(_registry),
+      path(_path),
+      MaxBatch(_MaxBatch),
+      BatchWait(_BatchWait) {
+  latency.reserve(LatencyWindow);
+}
+
+template <std::size_t Dimension, std::floating_point svm_float_t>
+void PredictionServer<Dimension, svm_float_t>::Run() {
+  const sockaddr_un address = SocketAddress(path);
+  listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  if (listener < 0) throw std::runtime_error("Fail to create socket.");
+  ::unlink(path.c_str());
+  if (::bind(listener, reinterpret_cast<const sockaddr*>(&address),
+             sizeof(address)) != 0 ||
+      ::listen(listener, SOMAXCONN) != 0) {
+    ::close(listener);
+    listener = -1;
+    throw std::runtime_error("Fail to listen on " + path + ".");
+  }
+  {
+    // 与Stop互斥，Stop要么看到running，要么先留下stop_requested
+    std::lock_guard lock(connection_mutex);
+    running = !std::exchange(stop_requested, false);
+  }
+  drained = false;
+  std::jthread batcher([&] { Batch(); });
+
+  while (running) {
+    const int fd = ::accept(listener, nullptr, nullptr);
+    if (fd < 0) {
+      if (errno == EINTR) continue;
+      break;
+    }
+    std::lock_guard lock(connection_mutex);
+    if (!running) {
+      ::close(fd);
+      break;
+    }
+    connections.push_back(fd);
+    connection_count = connections.size();
+    std::thread([this, fd] { Serve(fd); }).detach();
+  }
+  running = false;
+
+  // 唤醒仍阻塞在读取上的连接并等待其退出
+  std::unique_lock lock(connection_mutex);
+  for (int fd : connections) ::shutdown(fd, SHUT_RDWR);
+  connection_cv.wait(lock, [&] { return connections.empty(); });
+  // 本次运行期间收到的Stop不延续到下一次Run
+  stop_requested = false;
+  lock.unlock();
+  {
+    std::lock_guard queue_lock(queue_mutex);
+    drained = true;
+  }
+  queue_cv.notify_all();
+  batcher.join();
+  ::close(listener);
+  listener = -1;
+  ::unlink(path.c_str());
+}
+
+template <std::size_t Dimension, std::floating_point svm_float_t>
+void PredictionServer<Dimension, svm_float_t>::Stop() {
+  std::lock_guard lock(connection_mutex);
+  if (!running.exchange(false)) {
+    stop_requested = true;
+    return;
+  }
+  // 关闭监听套接字的读写使accept返回
+  ::shutdown(listener, SHUT_RDWR);
+}
+
+template <std::size_t Dimension, std::floating_point svm_float_t>
+void PredictionServer<Dimension, svm_float_t>::Batch() {
+  std::vector<data_t> data;
+  std::vector<svm_float_t> result;
+  for (;;) {
+    std::deque<Pending*> batch;
+    {
+      std::unique_lock lock(queue_mutex);
+      queue_cv.wait(lock, [&] { return !queue.empty() || drained; });
+      if (queue.empty()) return;
+      // 所有连接都已在等待时不会再有新请求到达，无需继续等待
+      queue_cv.wait_until(lock, clock::now() + BatchWait, [&] {
+        return queue_rows >= MaxBatch || queue.size() >= connection_count;
+      });
+      batch.swap(queue);
+      queue_rows = 0;
+    }
+
+    std::map<std::string, std::vector<Pending*>> group;
+    for (Pending* p : batch) group[p->model].push_back(p);
+    std::size_t rows = 0;
+    for (auto& [name, pending] : group) {
+      data.clear();
+      for (Pending* p : pending)
+        data.insert(data.end(), p->data.begin(), p->data.end());
+      result.resize(data.size());
+      rows += data.size();
+      // 整批使用同一版本的模型
+      auto model = registry.Find(name);
+      std::string error;
+      if (!model)
+        error = "Unknown model " + name + ".";
+      else
+        try {
+          model->Decision(data.data(), data.size(), result.data());
+        } catch (const std::exception& e) {
+          error = e.what();
+        }
+      for (std::size_t offset = 0; Pending* p : pending) {
+        p->error = error;
+        if (error.empty())
+          p->result.assign(result.begin() + offset,
+                           result.begin() + offset + p->data.size());
+        offset += p->data.size();
+        p->done.set_value();
+      }
+    }
+    std::lock_guard lock(latency_mutex);
+    counter.batches++;
+    counter.rows += rows;
+  }
+}
+
+template <std::size_t Dimension, std::floating_point svm_float_t>
+bool PredictionServer<Dimension, svm_float_t>::Respond(
+    int fd, ResponseStatus status, uint64_t count, const void* payload,
+    std::size_t size) {
+  ResponseHeader header;
+  header.status = status;
+  header.count = count;
+  return WriteFull(fd, &header, sizeof(header)) &&
+         WriteFull(fd, payload, size);
+}
+
+template <std::size_t Dimension, std::floating_point svm_float_t>
+void PredictionServer<Dimension, svm_float_t>::Serve(int fd) {
+  auto error = [&](const std::string& message) {
+    return Respond(fd, ResponseStatus::Error, message.size(), message.data(),
+                   message.size());
+  };
+  std::vector<svm_float_t> buffer;
+  for (RequestHeader header; ReadFull(fd, &header, sizeof(header));) {
+    const auto start = clock::now();
+    if (std::memcmp(header.magic, RequestHeader().magic, 4) != 0) break;
+    const std::string name(header.model,
+                           strnlen(header.model, ModelNameSize));
+
+    bool ok = true;
+    if (header.type == RequestType::Score) {
+      if (header.dimension != Dimension ||
+          header.float_size != sizeof(svm_float_t) ||
+          header.count > MaxRequestRows) {
+        // 负载长度不可信，回复错误后关闭连接而不读取负载
+        error("Mismatched score request.");
+        break;
+      }
+      buffer.resize(header.count * Dimension);
+      if (!ReadFull(fd, buffer.data(), buffer.size() * sizeof(svm_float_t)))
+        break;
+      Pending pending;
+      pending.model = name;
+      pending.data.resize(header.count);
+      for (std::size_t i = 0; i < header.count; i++)
+        for (std::size_t d = 0; d < Dimension; d++)
+          pending.data[i][d] = buffer[i * Dimension + d];
+      auto done = pending.done.get_future();
+      {
+        std::lock_guard lock(queue_mutex);
+        queue.push_back(&pending);
+        queue_rows += header.count;
+      }
+      queue_cv.notify_one();
+      done.wait();
+      ok = pending.error.empty()
+               ? Respond(fd, ResponseStatus::Ok, header.count,
+                         pending.result.data(),
+                         pending.result.size() * sizeof(svm_float_t))
+               : error(pending.error);
+    } else if (header.type == RequestType::Load) {
+      if (header.count > MaxModelPathSize) {
+        error("Model path is too long.");
+        break;
+      }
+      std::string file(header.count, '\0');
+      if (!ReadFull(fd, file.data(), file.size())) break;
+      try {
+        const uint64_t version = registry.Load(name, file);
+        ok = Respond(fd, ResponseStatus::Ok, version, nullptr, 0);
+      } catch (const std::exception& e) {
+        ok = error(e.what());
+      }
+    } else if (header.type == RequestType::Stats) {
+      const LatencyReport report = Latency();
+      ok = Respond(fd, ResponseStatus::Ok, 0, &report, sizeof(report));
+    } else
+      ok = error("Unknown request type.");
+    if (!ok) break;
+
+    if (header.type == RequestType::Score) {
+      const double us =
+          std::chrono::duration<double, std::micro>(clock::now() - start)
+              .count();
+      std::lock_guard lock(latency_mutex);
+      if (latency.size() < LatencyWindow)
+        latency.push_back(us);
+      else
+        latency[counter.requests % LatencyWindow] = us;
+      counter.requests++;
+    }
+  }
+
+  // 持锁关闭，避免fd被新连接复用后被误删
+  std::lock_guard lock(connection_mutex);
+  std::erase(connections, fd);
+  connection_count = connections.size();
+  ::close(fd);
+  connection_cv.notify_all();
+}
+
+template <std::size_t Dimension, std::floating_point svm_float_t>
+LatencyReport PredictionServer<Dimension, svm_float_t>::Latency() const {
+  std::vector<double> window;
+  LatencyReport report;
+  {
+    std::lock_guard lock(latency_mutex);
+    window = latency;
+    report = counter;
+  }
+  if (window.empty()) return report;
+  auto percentile = [&](double q) {
+    auto it = window.begin() + std::size_t(q * (window.size() - 1));
+    std::ranges::nth_element(window, it);
+    return *it;
+  };
+  report.p50 = percentile(0.5);
+  report.p99 = percentile(0.99);
+  report.max = std::ranges::max(window);
+  return report;
+}
+
+}  // namespace SVM
+
+#endif
\ No newline at end of file
@@ -0,0 +1,96 @@
+#ifndef __SVM_PROTOCOL_HPP__
+#define __SVM_PROTOCOL_HPP__
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace SVM {
+
+// 本地预测服务的二进制协议，请求与响应均为定长头部加变长负载
+// 双方运行于同一主机，字节序与浮点格式一致
+enum class RequestType : uint32_t {
+  Score,  // 负载为count行、每行dimension个浮点数，响应count个决策函数值
+  Load,   // 负载为count字节的模型文件路径，响应中count为新版本号
+  Stats   // 无负载，响应负载为LatencyReport
+};
+
+const std::size_t ModelNameSize = 48;
+// 单个打分请求的行数上限，防止异常请求耗尽内存；客户端按此分段发送
+const uint64_t MaxRequestRows = 1 << 20;
+// 加载请求中模型文件路径的字节数上限
+const uint64_t MaxModelPathSize = 4096;
+
+struct RequestHeader {
+  char magic[4] = {'S', 'V', 'M', 'Q'};
+  RequestType type = RequestType::Score;
+  uint32_t dimension = 0;
+  uint32_t float_size = 0;
+  uint64_t count = 0;
+  char model[ModelNameSize] = {};
+};
+
+enum class ResponseStatus : uint32_t {
+  Ok,
+  Error  // 负载为count字节的错误信息
+};
+
+struct ResponseHeader {
+  char magic[4] = {'S', 'V', 'M', 'R'};
+  ResponseStatus status = ResponseStatus::Ok;
+  uint64_t count = 0;
+};
+
+// 自收到请求至写回响应的服务端延迟，单位为微秒
+struct LatencyReport {
+  uint64_t requests = 0;
+  uint64_t batches = 0;
+  uint64_t rows = 0;
+  double p50 = 0, p99 = 0, max = 0;
+};
+
+// 读满size字节，对端关闭时返回false
+inline bool ReadFull(int fd, void* buffer, std::size_t size) {
+  char* p = static_cast<char*>(buffer);
+  while (size) {
+    const ssize_t n = ::read(fd, p, size);
+    if (n < 0 && errno == EINTR) continue;
+    if (n <= 0) return false;
+    p += n;
+    size -= n;
+  }
+  return true;
+}
+
+// 写满size字节，对端关闭时返回false而不触发SIGPIPE
+inline bool WriteFull(int fd, const void* buffer, std::size_t size) {
+  const char* p = static_cast<const char*>(buffer);
+  while (size) {
+    const ssize_t n = ::send(fd, p, size, MSG_NOSIGNAL);
+    if (n < 0 && errno == EINTR) continue;
+    if (n <= 0) return false;
+    p += n;
+    size -= n;
+  }
+  return true;
+}
+
+inline sockaddr_un SocketAddress(const std::string& path) {
+  sockaddr_un address{};
+  address.sun_family = AF_UNIX;
+  if (path.size() >= sizeof(address.sun_path))
+    throw std::runtime_error("Socket path is too long.");
+  std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+  return address;
+}
+
+}  // namespace SVM
+
+#endif
\ No newline at end of file
@@ -2,34 +2,44 @@
 #define __SVM_LINEAR_TEST_SAMPLE_GENERATOR_HPP__
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
 #include <cstddef>
 #include <cstdlib>
-#include <functional>
+#include <iterator>
 #include <random>
 
 #include "Sample/Sample.hpp"
 #include "SegmentPlane/SegmentPlane.hpp"
+#include "common/Parallel.hpp"
+#include "common/Philox.hpp"
 
 namespace SVM {
 
 template <std::size_t Dimension, std::floating_point svm_float_t = double>
 class LinearTestSampleGenerator {
   std::size_t GenCount = 0, ErrCount = 0;
+  std::size_t Seed;
   std::mt19937_64 Engine;
   std::uniform_real_distribution<svm_float_t> FloatDistribution;
+  std::uniform_real_distribution<svm_float_t> RandDistribuion{0, 1};
   // 基于Segmentation对空间进行分割
   SegmentPlane<Dimension, svm_float_t> Segmentation;
   svm_float_t FlipPossibility, FlipDistance;
 
-  std::function<svm_float_t()> get_float = [&] {
-    return FloatDistribution(Engine);
-  };
+  svm_float_t get_float() { return FloatDistribution(Engine); }
 
  public:
   explicit LinearTestSampleGenerator(std::size_t = 0, svm_float_t = 0,
                                      svm_float_t = 0, svm_float_t = -1,
                                      svm_float_t = 1);
   Sample<Dimension, svm_float_t> operator()();
+  // 以计数器随机数并行生成第[offset, offset + count)个样本写入first
+  // 结果只由种子与样本序号决定，与线程数无关
+  template <std::random_access_iterator randomIt>
+  void Generate(randomIt first, std::size_t count, std::size_t offset = 0,
+                std::size_t Threads = DefaultThreads());
 
   SegmentPlane<Dimension, svm_float_t> &GetSegmentation() {
     return Segmentation;
@@ -49,11 +59,12 @@ template <std::size_t Dimension, std::floating_point svm_float_t>
 LinearTestSampleGenerator<Dimension, svm_float_t>::LinearTestSampleGenerator(
     std::size_t seed, svm_float_t _FlipPossibility, svm_float_t _FlipDistance,
     svm_float_t distribution_lowerbound, svm_float_t distribution_upperbound)
-    : Engine(seed),
+    : Seed(seed),
+      Engine(seed),
       FloatDistribution(distribution_lowerbound, distribution_upperbound),
       FlipPossibility(_FlipPossibility),
       FlipDistance(_FlipDistance) {
-  std::ranges::generate(Segmentation.weight, get_float);
+  std::ranges::generate(Segmentation.weight, [&] { return get_float(); });
   Segmentation.bias = get_float() / 4;
 };
 
@@ -62,11 +73,10 @@ Sample<Dimension, svm_float_t>
 LinearTestSampleGenerator<Dimension, svm_float_t>::operator()() {
   GenCount++;
   Sample<Dimension, svm_float_t> sample;
-  std::ranges::generate(sample.data, get_float);
+  std::ranges::generate(sample.data, [&] { return get_float(); });
   svm_float_t &&classfication =
       Segmentation.weight.dot(sample.data) + Segmentation.bias;
 
-  static std::uniform_real_distribution<svm_float_t> RandDistribuion(0, 1);
   // 概率改变属性
   if (RandDistribuion(Engine) < FlipPossibility &&
       std::abs(classfication) <
@@ -80,6 +90,54 @@ LinearTestSampleGenerator<Dimension, svm_float_t>::operator()() {
   return sample;
 };
 
+template <std::size_t Dimension, std::floating_point svm_float_t>
+template <std::random_access_iterator randomIt>
+void LinearTestSampleGenerator<Dimension, svm_float_t>::Generate(
+    randomIt first, std::size_t count, std::size_t offset,
+    std::size_t Threads) {
+  // 每个样本需要Dimension + 1个随机数，每块提供两个
+  constexpr std::size_t Blocks = (Dimension + 2) / 2;
+  const Philox4x32 Random(Seed);
+  const svm_float_t lower = FloatDistribution.a(),
+                    range = FloatDistribution.b() - FloatDistribution.a();
+  const svm_float_t FlipBound =
+      FlipDistance * std::sqrt(Segmentation.weight.dot(Segmentation.weight));
+  const std::size_t TileSize = 1 << 14;
+  std::atomic<std::size_t> flipped = 0;
+
+  ParallelFor(
+      (count + TileSize - 1) / TileSize,
+      [&](std::size_t tile) {
+        std::size_t local_flipped = 0;
+        const std::size_t end = std::min(count, (tile + 1) * TileSize);
+        for (std::size_t i = tile * TileSize; i < end; i++) {
+          std::array<svm_float_t, Blocks * 2> u;
+          for (std::size_t b = 0; b < Blocks; b++) {
+            const auto block = Random(offset + i, b);
+            u[2 * b] = Philox4x32::Uniform<svm_float_t>(block, 0);
+            u[2 * b + 1] = Philox4x32::Uniform<svm_float_t>(block, 1);
+          }
+          Sample<Dimension, svm_float_t> sample;
+          for (std::size_t d = 0; d < Dimension; d++)
+            sample.data[d] = lower + range * u[d];
+          svm_float_t classfication =
+              Segmentation.weight.dot(sample.data) + Segmentation.bias;
+          if (u[Dimension] < FlipPossibility &&
+              std::abs(classfication) < FlipBound) {
+            classfication *= -1;
+            local_flipped++;
+          }
+          sample.classification = sgn(classfication);
+          first[i] = sample;
+        }
+        flipped += local_flipped;
+      },
+      Threads);
+
+  GenCount += count;
+  ErrCount += flipped;
+}
+
 }  // namespace SVM
 
 #endif
\ No newline at end of file
@@ -1,17 +1,22 @@
 #ifndef __SVM_MOON_TEST_SAMPLE_GENERATOR_HPP__
 #define __SVM_MOON_TEST_SAMPLE_GENERATOR_HPP__
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdlib>
+#include <iterator>
 #include <random>
 
 #include "Sample/Sample.hpp"
+#include "common/Parallel.hpp"
+#include "common/Philox.hpp"
 
 namespace SVM {
 
 // 生成双月牙形数据
 template <std::floating_point svm_float_t = double>
 class MoonTestSampleGenerator {
+  std::size_t Seed;
   std::mt19937_64 Engine;
   std::uniform_real_distribution<svm_float_t> FloatDistribution{-2.5, 2.5};
   std::uniform_real_distribution<svm_float_t> SpreadDistribution;
@@ -20,8 +25,15 @@ class MoonTestSampleGenerator {
  public:
   explicit MoonTestSampleGenerator(std::size_t seed = 0,
                                    svm_float_t SpreadRange = 0)
-      : Engine(seed), SpreadDistribution(-SpreadRange, SpreadRange){};
+      : Seed(seed),
+        Engine(seed),
+        SpreadDistribution(-SpreadRange, SpreadRange){};
   Sample<2, svm_float_t> operator()();
+  // 以计数器随机数并行生成第[offset, offset + count)个样本写入first
+  // 结果只由种子与样本序号决定，与线程数无关
+  template <std::random_access_iterator randomIt>
+  void Generate(randomIt first, std::size_t count, std::size_t offset = 0,
+                std::size_t Threads = DefaultThreads()) const;
 };
 
 }  // namespace SVM
@@ -43,6 +55,47 @@ Sample<2, svm_float_t> MoonTestSampleGenerator<svm_float_t>::operator()() {
   return sample;
 };
 
+template <std::floating_point svm_float_t>
+template <std::random_access_iterator randomIt>
+void MoonTestSampleGenerator<svm_float_t>::Generate(
+    randomIt first, std::size_t count, std::size_t offset,
+    std::size_t Threads) const {
+  const Philox4x32 Random(Seed);
+  const svm_float_t lower = FloatDistribution.a(),
+                    range = FloatDistribution.b() - FloatDistribution.a();
+  const svm_float_t spread_lower = SpreadDistribution.a(),
+                    spread_range = SpreadDistribution.b() - spread_lower;
+  const std::size_t TileSize = 1 << 14;
+
+  ParallelFor(
+      (count + TileSize - 1) / TileSize,
+      [&](std::size_t tile) {
+        const std::size_t end = std::min(count, (tile + 1) * TileSize);
+        for (std::size_t i = tile * TileSize; i < end; i++) {
+          const auto block0 = Random(offset + i, 0),
+                     block1 = Random(offset + i, 1);
+          Sample<2, svm_float_t> sample;
+          sample.classification =
+              Philox4x32::Uniform<svm_float_t>(block0, 0) < 0.5 ? -1 : 1;
+          sample.data[0] =
+              lower + range * Philox4x32::Uniform<svm_float_t>(block0, 1);
+          sample.data[1] = 2 *
+                           (sample.data[0] * sample.data[0] * 0.5 - 1.75) *
+                           sample.classification;
+          // 添加散布
+          sample.data[0] +=
+              spread_lower +
+              spread_range * Philox4x32::Uniform<svm_float_t>(block1, 0) +
+              sample.classification;
+          sample.data[1] +=
+              spread_lower +
+              spread_range * Philox4x32::Uniform<svm_float_t>(block1, 1);
+          first[i] = sample;
+        }
+      },
+      Threads);
+}
+
 }  // namespace SVM
 
 #endif
\ No newline at end of file
@@ -0,0 +1,129 @@
+#ifndef __SVM_FAST_MATH_HPP__
+#define __SVM_FAST_MATH_HPP__
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+namespace SVM {
+
+// 快速exp的精度级别，对应[-ln2 / 2, ln2 / 2]上Taylor多项式的次数
+enum class FastMathAccuracy {
+  Low,     // 相对误差约5e-5
+  Medium,  // 相对误差约2e-7，与float精度相当
+  High     // 与svm_float_t精度相当
+};
+
+// 无分支的exp，循环中调用时可被编译器向量化
+// x = n * ln2 + r，e^x = 2^n * e^r，2^n直接构造指数位
+// 结果下溢时返回0，上溢时返回inf
+template <FastMathAccuracy Accuracy, std::floating_point svm_float_t>
+inline svm_float_t FastExp(svm_float_t x) {
+  constexpr bool IsDouble = sizeof(svm_float_t) == sizeof(double);
+  static_assert(IsDouble || sizeof(svm_float_t) == sizeof(float));
+  using bits_t = std::conditional_t<IsDouble, uint64_t, uint32_t>;
+  constexpr int Mantissa = IsDouble ? 52 : 23;
+  constexpr svm_float_t Bias = IsDouble ? 1023 : 127;
+  constexpr svm_float_t Max = IsDouble ? 709 : 88, Min = IsDouble ? -708 : -87;
+  // ln2拆为高低两部分，高位部分与n的乘积无舍入误差
+  constexpr svm_float_t Ln2High =
+      IsDouble ? 6.93147180369123816490e-01 : 0.693359375f;
+  constexpr svm_float_t Ln2Low =
+      IsDouble ? 1.90821492927058770002e-10 : -2.12194440e-4f;
+  constexpr int Degree = Accuracy == FastMathAccuracy::Low      ? 4
+                         : Accuracy == FastMathAccuracy::Medium ? 6
+                         : IsDouble                             ? 12
+                                                                : 7;
+
+  // 以值而非引用选择，避免分支
+  const svm_float_t clamped = x < Min ? Min : x > Max ? Max : x;
+  // clamped * log2(e) + Offset恒为正，截断即为向下取整；不使用std::floor以便向量化
+  constexpr svm_float_t Offset = Bias + svm_float_t(0.5);
+  const int32_t k =
+      int32_t(clamped * svm_float_t(1.44269504088896340736) + Offset) -
+      int32_t(Bias);
+  const svm_float_t n = svm_float_t(k);
+#ifdef __FMA__
+  // 显式fma防止-ffast-math将两次减法合并，破坏ln2的拆分
+  const svm_float_t r = std::fma(-n, Ln2Low, std::fma(-n, Ln2High, clamped));
+#else
+  const svm_float_t r = clamped - n * Ln2High - n * Ln2Low;
+#endif
+
+  // Horner求sum r^i / i!，以折叠表达式展开，每步为一次乘加
+  constexpr auto Coefficient = [] {
+    std::array<svm_float_t, Degree + 1> c{1};
+    for (int i = 1; i <= Degree; i++) c[i] = c[i - 1] / i;
+    return c;
+  }();
+  svm_float_t p = Coefficient[Degree];
+  [&]<std::size_t... I>(std::index_sequence<I...>) {
+    ((p = p * r + Coefficient[Degree - 1 - I]), ...);
+  }(std::make_index_sequence<Degree>());
+
+  // 2^n直接构造指数位；下溢时取0，上溢时取inf
+  // 比较与选择均在浮点域内进行，严格浮点模式下也能向量化
+  svm_float_t scale =
+      std::bit_cast<svm_float_t>(bits_t(k + int32_t(Bias)) << Mantissa);
+  scale = x < Min ? 0 : scale;
+  scale = x > Max ? std::numeric_limits<svm_float_t>::infinity() : scale;
+  return p * scale;
+}
+
+// tanh(x) = sgn(x) * (1 - e^(-2|x|)) / (1 + e^(-2|x|))
+// 误差为绝对误差，x接近0时相对误差会放大
+template <FastMathAccuracy Accuracy, std::floating_point svm_float_t>
+inline svm_float_t FastTanh(svm_float_t x) {
+  const svm_float_t e = FastExp<Accuracy>(-2 * std::abs(x));
+  return std::copysign((1 - e) / (1 + e), x);
+}
+
+// 对data[0, n)原地求exp
+template <std::floating_point svm_float_t>
+void FastExp(svm_float_t* data, std::size_t n,
+             FastMathAccuracy Accuracy = FastMathAccuracy::High) {
+  switch (Accuracy) {
+    case FastMathAccuracy::Low:
+      for (std::size_t i = 0; i < n; i++)
+        data[i] = FastExp<FastMathAccuracy::Low>(data[i]);
+      break;
+    case FastMathAccuracy::Medium:
+      for (std::size_t i = 0; i < n; i++)
+        data[i] = FastExp<FastMathAccuracy::Medium>(data[i]);
+      break;
+    case FastMathAccuracy::High:
+      for (std::size_t i = 0; i < n; i++)
+        data[i] = FastExp<FastMathAccuracy::High>(data[i]);
+      break;
+  }
+}
+
+// 对data[0, n)原地求tanh
+template <std::floating_point svm_float_t>
+void FastTanh(svm_float_t* data, std::size_t n,
+              FastMathAccuracy Accuracy = FastMathAccuracy::High) {
+  switch (Accuracy) {
+    case FastMathAccuracy::Low:
+      for (std::size_t i = 0; i < n; i++)
+        data[i] = FastTanh<FastMathAccuracy::Low>(data[i]);
+      break;
+    case FastMathAccuracy::Medium:
+      for (std::size_t i = 0; i < n; i++)
+        data[i] = FastTanh<FastMathAccuracy::Medium>(data[i]);
+      break;
+    case FastMathAccuracy::High:
+      for (std::size_t i = 0; i < n; i++)
+        data[i] = FastTanh<FastMathAccuracy::High>(data[i]);
+      break;
+  }
+}
+
+}  // namespace SVM
+
+#endif
\ No newline at end of file
@@ -0,0 +1,130 @@
+#ifndef __SVM_PARALLEL_HPP__
+#define __SVM_PARALLEL_HPP__
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace SVM {
+
+inline std::size_t DefaultThreads() {
+  return std::max<std::size_t>(1, std::thread::hardware_concurrency());
+}
+
+// 以Threads个线程动态领取[0, n)中的任务并执行func(i)
+template <class Func>
+void ParallelFor(std::size_t n, const Func& func,
+                 std::size_t Threads = DefaultThreads()) {
+  Threads = std::min(Threads, n);
+  if (Threads <= 1) {
+    for (std::size_t i = 0; i < n; i++) func(i);
+    return;
+  }
+  std::atomic<std::size_t> next = 0;
+  std::vector<std::jthread> workers;
+  workers.reserve(Threads);
+  for (std::size_t t = 0; t < Threads; t++)
+    workers.emplace_back([&] {
+      for (std::size_t i; (i = next.fetch_add(1)) < n;) func(i);
+    });
+}
+
+// 常驻线程池，频繁执行短小的并行循环时避免每次创建线程
+// ParallelFor的语义同全局的ParallelFor，调用线程也参与执行；
+// 同一时刻只能有一个线程调用ParallelFor
+class ThreadPool {
+  std::vector<std::jthread> workers;
+  std::mutex mutex;
+  std::condition_variable start_cv, done_cv;
+  // 当前任务，以函数指针擦除类型避免分配
+  void (*invoke)(const void*, std::size_t) = nullptr;
+  const void* func = nullptr;
+  std::size_t size = 0;
+  std::atomic<std::size_t> next = 0;
+  std::size_t generation = 0, busy = 0;
+  bool stop = false;
+
+  void Drain();
+  void Work();
+
+ public:
+  explicit ThreadPool(std::size_t Threads = DefaultThreads());
+  ~ThreadPool();
+  ThreadPool(const ThreadPool&) = delete;
+
+  std::size_t Threads() const { return workers.size() + 1; }
+  template <class Func>
+  void ParallelFor(std::size_t n, const Func& func);
+};
+
+}  // namespace SVM
+
+//////////implementation//////////
+
+namespace SVM {
+
+inline ThreadPool::ThreadPool(std::size_t Threads) {
+  Threads = std::max<std::size_t>(1, Threads);
+  workers.reserve(Threads - 1);
+  for (std::size_t t = 1; t < Threads; t++)
+    workers.emplace_back([this] { Work(); });
+}
+
+inline ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard lock(mutex);
+    stop = true;
+  }
+  start_cv.notify_all();
+  // 须在mutex等成员析构前汇合
+  workers.clear();
+}
+
+inline void ThreadPool::Drain() {
+  for (std::size_t i; (i = next.fetch_add(1)) < size;) invoke(func, i);
+}
+
+inline void ThreadPool::Work() {
+  for (std::size_t seen = 0;;) {
+    std::unique_lock lock(mutex);
+    start_cv.wait(lock, [&] { return stop || generation != seen; });
+    if (stop) return;
+    seen = generation;
+    lock.unlock();
+    Drain();
+    lock.lock();
+    if (--busy == 0) done_cv.notify_one();
+  }
+}
+
+template <class Func>
+void ThreadPool::ParallelFor(std::size_t n, const Func& _func) {
+  if (workers.empty() || n <= 1) {
+    for (std::size_t i = 0; i < n; i++) _func(i);
+    return;
+  }
+  {
+    std::lock_guard lock(mutex);
+    invoke = [](const void* f, std::size_t i) {
+      (*static_cast<const Func*>(f))(i);
+    };
+    func = &_func;
+    size = n;
+    next = 0;
+    busy = workers.size();
+    generation++;
+  }
+  start_cv.notify_all();
+  Drain();
+  // 各工作线程在本轮结束前都会领取一次，等待其全部退出Drain
+  std::unique_lock lock(mutex);
+  done_cv.wait(lock, [&] { return busy == 0; });
+}
+
+}  // namespace SVM
+
+#endif
\ No newline at end of file
@@ -0,0 +1,50 @@
+#ifndef __SVM_PHILOX_HPP__
+#define __SVM_PHILOX_HPP__
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "common/common.hpp"
+
+namespace SVM {
+
+// Philox4x32-10计数器随机数生成器
+// 每个随机块只由种子与(counter, stream)决定，与生成顺序及线程数无关
+class Philox4x32 {
+  std::array<uint32_t, 2> key;
+
+ public:
+  using block_t = std::array<uint32_t, 4>;
+
+  explicit Philox4x32(uint64_t seed)
+      : key{uint32_t(seed), uint32_t(seed >> 32)} {}
+
+  block_t operator()(uint64_t counter, uint64_t stream = 0) const {
+    block_t x{uint32_t(counter), uint32_t(counter >> 32), uint32_t(stream),
+              uint32_t(stream >> 32)};
+    uint32_t k0 = key[0], k1 = key[1];
+    for (int round = 0; round < 10; round++) {
+      const uint64_t p0 = uint64_t(0xD2511F53) * x[0];
+      const uint64_t p1 = uint64_t(0xCD9E8D57) * x[2];
+      x = {uint32_t(p1 >> 32) ^ x[1] ^ k0, uint32_t(p1),
+           uint32_t(p0 >> 32) ^ x[3] ^ k1, uint32_t(p0)};
+      k0 += 0x9E3779B9;
+      k1 += 0xBB67AE85;
+    }
+    return x;
+  }
+
+  // 以块中第k对(k = 0, 1)32位整数构造[0, 1)上的浮点数
+  template <std::floating_point svm_float_t>
+  static svm_float_t Uniform(const block_t& block, int k) {
+    if constexpr (sizeof(svm_float_t) < sizeof(double))
+      return svm_float_t(block[2 * k] >> 8) * svm_float_t(0x1p-24);
+    const uint64_t bits = uint64_t(block[2 * k]) << 32 | block[2 * k + 1];
+    return svm_float_t(bits >> 11) * svm_float_t(0x1p-53);
+  }
+};
+
+}  // namespace SVM
+
+#endif
\ No newline at end of file
@@ -24,7 +24,9 @@ template <std::size_t Dimension, std::floating_point svm_float_t = double>
 class FixedVector {
   using value_type = svm_float_t;
 #ifdef __USE_EIGEN__
-  Eigen::Vector<svm_float_t, (int)Dimension> content;
+  // 与std::array值初始化的行为保持一致
+  Eigen::Vector<svm_float_t, (int)Dimension> content =
+      Eigen::Vector<svm_float_t, (int)Dimension>::Zero();
   using iterator = decltype(content.begin());
   using const_iterator = decltype(content.cbegin());
 #else
@@ -44,11 +46,23 @@ class FixedVector {
   svm_float_t dot(const FixedVector<Dimension, svm_float_t>&) const;
   FixedVector operator*(const svm_float_t&) const;
 
+  // 原地运算，避免热点路径中构造临时向量
+  FixedVector& operator+=(const FixedVector<Dimension, svm_float_t>&);
+  FixedVector& operator-=(const FixedVector<Dimension, svm_float_t>&);
+  FixedVector& operator*=(const svm_float_t&);
+  // this += k * x
+  FixedVector& axpy(const svm_float_t&,
+                    const FixedVector<Dimension, svm_float_t>&);
+  // |this - b|^2
+  svm_float_t squared_distance(
+      const FixedVector<Dimension, svm_float_t>&) const;
+
   constexpr const_iterator begin() const { return content.begin(); }
   constexpr const_iterator end() const { return content.end(); }
   constexpr iterator begin() { return content.begin(); }
   constexpr iterator end() { return content.end(); }
   svm_float_t& operator[](int index) { return content[index]; }
+  const svm_float_t& operator[](int index) const { return content[index]; }
 };
 
 using ClassificationType = int;
@@ -106,6 +120,42 @@ FixedVector<Dimension, svm_float_t>::operator*(const svm_float_t& k) const {
   std::ranges::transform(a, a.begin(), [&](const auto& x) { return x * k; });
   return a;
 }
+template <std::size_t Dimension, std::floating_point svm_float_t>
+FixedVector<Dimension, svm_float_t>&
+FixedVector<Dimension, svm_float_t>::operator+=(
+    const FixedVector<Dimension, svm_float_t>& b) {
+  for (std::size_t i = 0; i < Dimension; i++) content[i] += b.content[i];
+  return *this;
+}
+template <std::size_t Dimension, std::floating_point svm_float_t>
+FixedVector<Dimension, svm_float_t>&
+FixedVector<Dimension, svm_float_t>::operator-=(
+    const FixedVector<Dimension, svm_float_t>& b) {
+  for (std::size_t i = 0; i < Dimension; i++) content[i] -= b.content[i];
+  return *this;
+}
+template <std::size_t Dimension, std::floating_point svm_float_t>
+FixedVector<Dimension, svm_float_t>&
+FixedVector<Dimension, svm_float_t>::operator*=(const svm_float_t& k) {
+  for (auto& x : content) x *= k;
+  return *this;
+}
+template <std::size_t Dimension, std::floating_point svm_float_t>
+FixedVector<Dimension, svm_float_t>& FixedVector<Dimension, svm_float_t>::axpy(
+    const svm_float_t& k, const FixedVector<Dimension, svm_float_t>& x) {
+  for (std::size_t i = 0; i < Dimension; i++) content[i] += k * x.content[i];
+  return *this;
+}
+template <std::size_t Dimension, std::floating_point svm_float_t>
+svm_float_t FixedVector<Dimension, svm_float_t>::squared_distance(
+    const FixedVector<Dimension, svm_float_t>& b) const {
+  svm_float_t sum = 0;
+  for (std::size_t i = 0; i < Dimension; i++) {
+    const svm_float_t d = content[i] - b.content[i];
+    sum += d * d;
+  }
+  return sum;
+}
 #else
 template <std::size_t Dimension, std::floating_point svm_float_t>
 svm_float_t FixedVector<Dimension, svm_float_t>::dot(
@@ -135,6 +185,37 @@ FixedVector<Dimension, svm_float_t>::operator*(const svm_float_t& k) const {
   a.content *= k;
   return a;
 }
+template <std::size_t Dimension, std::floating_point svm_float_t>
+FixedVector<Dimension, svm_float_t>&
+FixedVector<Dimension, svm_float_t>::operator+=(
+    const FixedVector<Dimension, svm_float_t>& b) {
+  content += b.content;
+  return *this;
+}
+template <std::size_t Dimension, std::floating_point svm_float_t>
+FixedVector<Dimension, svm_float_t>&
+FixedVector<Dimension, svm_float_t>::operator-=(
+    const FixedVector<Dimension, svm_float_t>& b) {
+  content -= b.content;
+  return *this;
+}
+template <std::size_t Dimension, std::floating_point svm_float_t>
+FixedVector<Dimension, svm_float_t>&
+FixedVector<Dimension, svm_float_t>::operator*=(const svm_float_t& k) {
+  content *= k;
+  return *this;
+}
+template <std::size_t Dimension, std::floating_point svm_float_t>
+FixedVector<Dimension, svm_float_t>& FixedVector<Dimension, svm_float_t>::axpy(
+    const svm_float_t& k, const FixedVector<Dimension, svm_float_t>& x) {
+  content += k * x.content;
+  return *this;
+}
+template <std::size_t Dimension, std::floating_point svm_float_t>
+svm_float_t FixedVector<Dimension, svm_float_t>::squared_distance(
+    const FixedVector<Dimension, svm_float_t>& b) const {
+  return (content - b.content).squaredNorm();
+}
 #endif
 };  // namespace SVM
 